@@ -8,6 +8,8 @@ uniform vec3 color;
 
 void main()
 {
-	gl_Position = modelRot* vec4(aPos, 1.0);
+	//instance 1 is the mirror image of the model
+	vec3 zScale = vec3(1.0, 1.0, (gl_InstanceID == 1) ? -1.0 : 1.0);
+	gl_Position = modelRot* vec4(aPos * zScale, 1.0);
 	vertexColor = color;
 }
\ No newline at end of file
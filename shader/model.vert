@@ -11,8 +11,11 @@ uniform vec3 color;
 
 void main()
 {
-	gl_Position = modelRot* vec4(aPos, 1.0);
+	//instance 1 is the mirror image of the model
+	vec3 zScale = vec3(1.0, 1.0, (gl_BaseInstance + gl_InstanceID == 1) ? -1.0 : 1.0);
+	vec3 p = aPos * zScale;
+	gl_Position = modelRot* vec4(p, 1.0);
 	pos = vec3(gl_Position);
 	vertexColor = color;
-	normal =vec3(modelRot*(vec4(normalize(aNorm)+aPos,1.0))-gl_Position);
+	normal =vec3(modelRot*(vec4(normalize(aNorm * zScale)+p,1.0))-gl_Position);
 }
\ No newline at end of file
@@ -9,72 +9,90 @@
  */
 
 #include "2dpoly_to_3d.hpp"
+#include "predicates.hpp"
+#include <cmath>
 
 namespace sketch3D {
-	poly_to_3D::poly_to_3D(graph::graph* graph) :
-		directedGraph(graph),
-		cdt(directedGraph),
-		spineEstimator(directedGraph),
-		modeler(directedGraph),
-		point3DNum(0),
+	poly_to_3D::poly_to_3D() :
+		directedGraph(),
+		cdt(&directedGraph),
+		earClipper(&directedGraph),
+		spineEstimator(&directedGraph),
+		modeler(&directedGraph),
+		inputPointNum(0), snapshotLevel(SNAPSHOT_ALL),
+		constraints(),
+		inputPoints(), snapshots(),
+		spines(),spineNum(),
 		points3D(),faces(),
 		pointNormal(),
-		points2D(), edges(),
-		point2DNum(), edgeNum(),inputPointNum(0),
-		spines(),spineNum()
+		point3DNum(0), seamPointNum(0), modelStored(false)
 	{
 	}
 
-	poly_to_3D::~poly_to_3D() {
-		delete[] points2D[0];
-		delete[] points2D[1];
-		delete[] points2D[2];
-		delete[] points2D[3];
-		delete[] points2D[4];
-		delete[] edges[0];
-		delete[] edges[1];
-		delete[] edges[2];
-		delete[] edges[3];
-		delete[] edges[4];
-		delete[] spines[0];
-		delete[] spines[1];
-
-		delete[] points3D;
-		delete[] pointNormal;
-		delete[] faces;
-	}
+	poly_to_3D::~poly_to_3D() {}
 
 	void poly_to_3D::init() {
-		directedGraph->init();
+		directedGraph.init();
 		cdt.init();
 		spineEstimator.init();
 		point3DNum = 0;
+		seamPointNum = 0;
+		modelStored = false;
 		inputPointNum = 0;
 	}
 
+	//all points are on a line or not (such a polygon has no inside)
+	static bool isCollinear(double* point_coords, size_t pointNum) {
+		graph::point p1(point_coords[0], point_coords[1]);
+		graph::point p2;
+		size_t i = 1;
+		for (; i < pointNum; i++) {
+			p2 = graph::point(point_coords[i * 2], point_coords[i * 2 + 1]);
+			if (p2.getX() != p1.getX() || p2.getY() != p1.getY()) break;
+		}
+		for (i++; i < pointNum; i++) {
+			if (graph::orient2D(p1, p2, graph::point(point_coords[i * 2], point_coords[i * 2 + 1])) != 0) return false;
+		}
+		return true;
+	}
+
 	//generate 3D model from 2D polygon
-	void poly_to_3D::genModel(double* point_coords, size_t pointNum) {
+	void poly_to_3D::genModel(double* point_coords, size_t pointNum, int triangulator) {
 		if (pointNum < 5) {
 			throw(graph::graphException("poly_to_3D", "genModel: The number of points should be 5 or more.", false));
 		}
+		for (size_t i = 0; i < pointNum * 2; i++) {
+			if (!std::isfinite(point_coords[i])) {
+				throw(graph::graphException("poly_to_3D", "genModel: Coordinates should be finite numbers.", false));
+			}
+		}
+		if (isCollinear(point_coords, pointNum)) {
+			throw(graph::graphException("poly_to_3D", "genModel: The polygon has no area (all points are on a line).", false));
+		}
 		init();
 		inputPointNum = pointNum;
-		delete[] points2D[0];
-		points2D[0] = new double[inputPointNum * 2];
-		memmove(points2D[0], point_coords, sizeof(double) * inputPointNum * 2);
-		size_t* constraints = new size_t[pointNum * 2];
+		inputPoints.assign(point_coords, point_coords + inputPointNum * 2);
+		constraints.resize(pointNum * 2);
 		for (size_t i = 0; i < pointNum; i++) {
 			constraints[i * 2] = i;
 			constraints[i * 2 + 1] = (i < pointNum - 1) ? i + 1 : 0;
 		}
-		cdt.defineProblem(point_coords, pointNum, constraints, pointNum);
+		cdt.defineProblem(point_coords, pointNum, constraints.data(), pointNum);
 		store2DPolyData(0);
-		cdt.solve();
-		//cdt.checkAllConstraintEdgeExist(cdt.getPointNum());
-		store2DPolyData(1);
-		delete[] constraints;
-		spineEstimator.init();
-		spineEstimator.deleteExternalEdge();
+		if (triangulator == TRIANGULATOR_EAR_CLIPPING) {
+			//triangulates inside of the polygon
+			earClipper.solve(pointNum);
+			store2DPolyData(1);
+			spineEstimator.init();
+			spineEstimator.checkAllConstraintEdgeExist(pointNum, true);
+		}
+		else {
+			cdt.solve();
+			//cdt.checkAllConstraintEdgeExist(cdt.getPointNum());
+			store2DPolyData(1);
+			spineEstimator.init();
+			spineEstimator.deleteExternalEdge();
+		}
 		store2DPolyData(2);
 		spineEstimator.genSpineFromChordalAxis();
 		storeSpineData(0);
@@ -93,15 +111,38 @@ namespace sketch3D {
 		modeler.graphTo3D(pointNum);
 		//modeler.checkDuplicatePoint();
 		//modeler.checkDuplicateEdge();
-		storeModelData();
+
+		//model data is copied on the first access (writeModel doesn't need it)
+		point3DNum = directedGraph.getPointNum();
+		seamPointNum = modeler.getSeamPointNum();
+		modelStored = false;
+	}
+
+	void poly_to_3D::setInsertionOrder(int order) {
+		cdt.setInsertionOrder(order);
+	}
+
+	void poly_to_3D::setRingNum(size_t num) {
+		modeler.setRingNum(num);
+	}
+
+	void poly_to_3D::setSnapshotLevel(int level) {
+		snapshotLevel = level;
+	}
+
+	int poly_to_3D::getSnapshotLevel() {
+		return snapshotLevel;
 	}
 
 	//get spine data
 	void poly_to_3D::storeSpineData(size_t id) {
-		delete[] spines[id];
+		if (snapshotLevel == SNAPSHOT_NONE || (snapshotLevel == SNAPSHOT_FINAL && id != 1)) {
+			spineNum[id] = 0;
+			return;
+		}
 		spineNum[id] = spineEstimator.getSpineNum();
-		spines[id] = new double[spineNum[id] * 4];
-		spineEstimator.getSpinesAsCoords(spines[id]);
+		spines[id].resize(spineNum[id] * 4);
+		spineEstimator.getSpinesAsCoords(spines[id].data());
 	}
 
 	size_t poly_to_3D::getSpineNum(size_t id) {
@@ -109,67 +150,118 @@ namespace sketch3D {
 	}
 
 	double* poly_to_3D::getPointerToSpines(size_t id) {
-		return spines[id];
+		if (spineNum[id] == 0) return nullptr;
+		return spines[id].data();
 	}
 
 
 	//get 2D polygon data
 
 	void poly_to_3D::store2DPolyData(size_t id) {
-		point2DNum[id] = directedGraph->getPointNum();
-		edgeNum[id]= directedGraph->getEdgeNum();
-
-		delete[] points2D[id];
-		delete[] edges[id];
+		polySnapshot& snapshot = snapshots[id];
+		snapshot.recorded = snapshotLevel == SNAPSHOT_ALL || (snapshotLevel == SNAPSHOT_FINAL && id == 4);
+		snapshot.materialized = false;
+		if (!snapshot.recorded) {
+			snapshot.pointNum = 0;
+			snapshot.edgeNum = 0;
+			return;
+		}
 
-		points2D[id] = new double[point2DNum[id] * 2];
-		edges[id] = new double[edgeNum[id] * 4];
+		//only indices of edges are copied here
+		snapshot.pointNum = directedGraph.getPointNum();
+		snapshot.edgeNum = directedGraph.getEdgeNum();
+		snapshot.points.resize(snapshot.pointNum * 2);
+		snapshot.edgePoints.resize(snapshot.edgeNum * 2);
+		directedGraph.getPointsEdges(snapshot.points.data(), snapshot.edgePoints.data());
+	}
 
-		directedGraph->getPointsEdgesAsCoords(points2D[id], edges[id]);
+	void poly_to_3D::materializeSnapshot(size_t id) {
+		polySnapshot& snapshot = snapshots[id];
+		if (!snapshot.recorded || snapshot.materialized) return;
+		snapshot.edges.resize(snapshot.edgeNum * 4);
+		const double* points = snapshot.points.data();
+		const graph::pointIndex* edgePoints = snapshot.edgePoints.data();
+		double* edges = snapshot.edges.data();
+		graph::pointIndex p1, p2;
+		for (size_t i = 0; i < snapshot.edgeNum; i++) {
+			p1 = edgePoints[i * 2];
+			p2 = edgePoints[i * 2 + 1];
+			edges[i * 4] = points[p1 * 2];
+			edges[i * 4 + 1] = points[p1 * 2 + 1];
+			edges[i * 4 + 2] = points[p2 * 2];
+			edges[i * 4 + 3] = points[p2 * 2 + 1];
+		}
+		snapshot.materialized = true;
 	}
 
 	double* poly_to_3D::getPointerToPoints2D(size_t id) {
-		return points2D[id];
+		if (!snapshots[id].recorded) return nullptr;
+		return snapshots[id].points.data();
 	}
 	size_t poly_to_3D::getPoint2DNum(size_t id) {
-		return point2DNum[id];
+		return snapshots[id].pointNum;
 	}
 	double* poly_to_3D::getPointerToEdges(size_t id) {
-		return edges[id];
+		if (!snapshots[id].recorded) return nullptr;
+		materializeSnapshot(id);
+		return snapshots[id].edges.data();
 	}
 	size_t poly_to_3D::getEdgeNum(size_t id) {
-		return edgeNum[id];
+		return snapshots[id].edgeNum;
 	}
 
 	//get 3D model data
 
 	void poly_to_3D::storeModelData() {
+		if (modelStored || point3DNum == 0) return;
 		size_t faceNum = getFaceNum();
-		point3DNum = directedGraph->getPointNum();
-		delete[] points3D;
-		delete[] pointNormal;
-		delete[] faces;
-		points3D = new double[point3DNum * 3];
-		pointNormal = new double[point3DNum * 3];
-		faces = new size_t[faceNum * 3];
-		modeler.getPointsFacesNormals(points3D, faces, pointNormal);
+		points3D.resize(point3DNum * 3);
+		pointNormal.resize(point3DNum * 3);
+		faces.resize(faceNum * 3);
+		modeler.getPointsFacesNormals(points3D.data(), faces.data(), pointNormal.data());
+		modelStored = true;
 	}
 
 	double* poly_to_3D::getPointerToPoints3D() {
-		return points3D;
+		storeModelData();
+		return points3D.data();
 	}
 	size_t poly_to_3D::getPoint3DNum() {
 		return point3DNum;
 	}
 	size_t* poly_to_3D::getPointerToFaces() {
-		return faces;
+		storeModelData();
+		return faces.data();
 	}
 	size_t poly_to_3D::getFaceNum() {
 		return modeler.getFaceNum();
 	}
+	size_t poly_to_3D::getSeamPointNum() {
+		return seamPointNum;
+	}
+
+	size_t poly_to_3D::getExactPredicateNum() {
+		return directedGraph.getExactPredicateNum();
+	}
 
 	double* poly_to_3D::getPointerToPointNormal() {
-		return pointNormal;
+		storeModelData();
+		return pointNormal.data();
+	}
+
+	size_t poly_to_3D::getModelPointNum(bool mirrored) {
+		if (point3DNum == 0) return 0;
+		return modeler.getModelPointNum(mirrored);
+	}
+	size_t poly_to_3D::getModelFaceNum(bool mirrored) {
+		if (point3DNum == 0) return 0;
+		return modeler.getModelFaceNum(mirrored);
+	}
+
+	bool poly_to_3D::writeModel(float* point_coords, uint32_t* face_IDs, float* normals, bool mirrored) {
+		if (point3DNum == 0) return false;
+		modeler.getPointsFacesNormals(point_coords, face_IDs, normals, mirrored);
+		return true;
 	}
 
 	//
@@ -177,16 +269,22 @@ namespace sketch3D {
 	
 
 	
-	bool poly_to_3D::exportAsObj(WCHAR* FileName) {
-		if (point3DNum == 0) {
-			return false;
-		}
+	std::string poly_to_3D::objString() {
+		storeModelData();
+		//the -z half is emitted here.
+		//mirrored points are appended after the stored ones (seam points are shared)
+		size_t mirrorOffset = point3DNum - seamPointNum;
 		std::string str = "#vertices\n";
 		for (size_t i = 0; i < point3DNum; i++) {
 			str += "v " + std::to_string(points3D[i * 3]) + " ";
 			str += std::to_string(points3D[i * 3 + 1]) + " ";
 			str += std::to_string(points3D[i * 3 + 2]) + "\n";
 		}
+		for (size_t i = seamPointNum; i < point3DNum; i++) {
+			str += "v " + std::to_string(points3D[i * 3]) + " ";
+			str += std::to_string(points3D[i * 3 + 1]) + " ";
+			str += std::to_string(-points3D[i * 3 + 2]) + "\n";
+		}
 		str += "\n#faces\n";
 		size_t faceNum = getFaceNum();
 		for (size_t i = 0; i < faceNum; i++) {
@@ -194,48 +292,40 @@ namespace sketch3D {
 			str += std::to_string(faces[i * 3 + 1]+1) + " ";
 			str += std::to_string(faces[i * 3 + 2]+1) + "\n";
 		}
-
-		return fileUtils::write_txt(FileName, str);
-	}
-
-	bool poly_to_3D::exportAsStroke(const WCHAR* file_path, const char* desc) {
-		if (inputPointNum != 0) {
-			std::string str(desc);
-			str = "type:stroke\ndesc:" + str + "\n"
-				+ stringUtils::array_to_string(points2D[0], inputPointNum * 2, 8);
-			fileUtils::write_txt(file_path, str);
-			return true;
+		//mirrored faces (p2, p1, p3) keep the normals outside
+		size_t p[3];
+		for (size_t i = 0; i < faceNum; i++) {
+			for (size_t j = 0; j < 3; j++) {
+				p[j] = faces[i * 3 + j];
+				if (p[j] >= seamPointNum) {
+					p[j] += mirrorOffset;
+				}
+			}
+			str += "f " + std::to_string(p[1] + 1) + " ";
+			str += std::to_string(p[0] + 1) + " ";
+			str += std::to_string(p[2] + 1) + "\n";
 		}
-		return false;
+		return str;
 	}
-	bool poly_to_3D::exportAsStroke(const char* file_path, const char* desc) {
-		if (inputPointNum != 0) {
-			std::string str(desc);
-			str = "type:stroke\ndesc:" + str + "\n" 
-				+ stringUtils::array_to_string(points2D[0], inputPointNum*2, 8);
-			fileUtils::write_txt(file_path, str);
-			return true;
-		}
-		return false;
+
+	std::string poly_to_3D::strokeString(const char* desc) {
+		std::string str(desc);
+		return "type:stroke\ndesc:" + str + "\n"
+			+ stringUtils::array_to_string(inputPoints.data(), inputPointNum * 2, 8);
 	}
 
-	bool poly_to_3D::importStroke(const WCHAR* file_path) {
-		
-		std::string str = fileUtils::read_txt(file_path);
+	void poly_to_3D::genModelFromStroke(const std::string& str, int triangulator) {
 		if (str == "") {
 			throw(graph::graphException("poly_to_3D","importStroke: Failed to read a file.",false));
-			return false;
 		}
 		std::vector<std::string> vec = stringUtils::split(str, '\n');
 		if (vec.size() < 3) {
 			throw(graph::graphException("poly_to_3D", "importStroke: File format error detected.", false));
-			return false;
 		}
 
 		std::vector<std::string> desc = stringUtils::split(vec[1], ':');
-		if (vec[0] != "type:stroke" || desc[0] != "desc") {
+		if (vec[0] != "type:stroke" || desc.empty() || desc[0] != "desc") {
 			throw(graph::graphException("poly_to_3D", "importStroke: File format error detected.", false));
-			return false;
 		}
 
 		std::string data;
@@ -248,20 +338,58 @@ namespace sketch3D {
 		size_t size = stringUtils::count(data, ',') + 1;
 		if (size<10) {
 			throw(graph::graphException("poly_to_3D", "importStroke: Stroke is too short.", false));
-			return false;
 		}
 		if (size % 2 == 1) {
 			throw(graph::graphException("poly_to_3D", "importStroke: The size of Data array should be even.", false));
-			return false;
 		}
-		double* point_coords = new double[size];
-		stringUtils::string_to_array(data, point_coords, size);
+		std::vector<double> point_coords(size);
+		stringUtils::string_to_array(data, point_coords.data(), size);
 		//printf("%s\n",stringUtils::array_to_string(point_coords, size).c_str());
 		
-		genModel(point_coords, size/2);
-		delete[] point_coords;
+		genModel(point_coords.data(), size/2, triangulator);
+	}
+
+	bool poly_to_3D::exportAsObj(const char* file_path) {
+		if (point3DNum == 0) {
+			return false;
+		}
+		return fileUtils::write_txt(file_path, objString());
+	}
+
+	bool poly_to_3D::exportAsStroke(const char* file_path, const char* desc) {
+		if (inputPointNum != 0) {
+			fileUtils::write_txt(file_path, strokeString(desc));
+			return true;
+		}
+		return false;
+	}
+
+	bool poly_to_3D::importStroke(const char* file_path, int triangulator) {
+		genModelFromStroke(fileUtils::read_txt(file_path), triangulator);
+		return true;
+	}
+
+#ifdef _WIN32
+	bool poly_to_3D::exportAsObj(WCHAR* FileName) {
+		if (point3DNum == 0) {
+			return false;
+		}
+		return fileUtils::write_txt(FileName, objString());
+	}
+
+	bool poly_to_3D::exportAsStroke(const WCHAR* file_path, const char* desc) {
+		if (inputPointNum != 0) {
+			fileUtils::write_txt(file_path, strokeString(desc));
+			return true;
+		}
+		return false;
+	}
+
+	bool poly_to_3D::importStroke(const WCHAR* file_path, int triangulator) {
+		genModelFromStroke(fileUtils::read_txt(file_path), triangulator);
 		return true;
 	}
+#endif
 
 	void poly_to_3D::loadGraph(const char* file_path) {
 		modeler.loadGraph(file_path);
@@ -11,47 +11,105 @@
 #pragma once
 
 #include "cdt.hpp"
+#include "earClipper.hpp"
 #include "spineEstimator.hpp"
 #include "modeler.hpp"
 
 namespace sketch3D {
+
+	const int TRIANGULATOR_CDT = 0;// CDT with a super triangle (default)
+	const int TRIANGULATOR_EAR_CLIPPING = 1;// ear clipping + edge flips (no external faces)
+
+	const int SNAPSHOT_NONE = 0;// stores no 2D stages and spines (batch mode)
+	const int SNAPSHOT_FINAL = 1;// stores the last 2D stage (4) and the cut spines (1)
+	const int SNAPSHOT_ALL = 2;// stores all 2D stages and spines (default)
+
+	//a 2D stage of genModel.
+	//points and edges are recorded as indices, and coordinates of edges are made on the first access.
+	struct polySnapshot {
+		bool recorded;
+		bool materialized;// edges has coordinates of edgePoints
+		size_t pointNum;
+		size_t edgeNum;
+		std::vector<double> points;// {p1_x, p1_y, p2_x, ...}
+		std::vector<graph::pointIndex> edgePoints;// {e1_p1, e1_p2, e2_p1, ...}
+		std::vector<double> edges;// {e1_x1, e1_y1, e1_x2, e1_y2, e2_x1, ...}
+		polySnapshot() : recorded(false), materialized(false), pointNum(0), edgeNum(0), points(), edgePoints(), edges() {}
+	};
+
+	//a pipeline context. it owns its graph, work buffers and outputs,
+	//so contexts in different threads can call genModel at the same time without locks.
 	class poly_to_3D {
 	private:
 
-		graph::graph* directedGraph;
+		graph::graph directedGraph;// (declared first, since the handlers below keep a pointer to it)
 		CDTsolver cdt;
-		spineEstimator spineEstimator;
-		modeler modeler;
+		sketch3D::earClipper earClipper;// (qualified names, since members have the same names as classes)
+		sketch3D::spineEstimator spineEstimator;
+		sketch3D::modeler modeler;
 
 		size_t inputPointNum;// the number of vertices in 2D polygon
-
-		double* points2D[5];
-		double* edges[5];// edge coordinates of 2D polygon
-		double* spines[2];
-
-		size_t point2DNum[5];//the number of vertices in 2D polygon
-		size_t edgeNum[5];//the number of edges in 2D polygon
+		int snapshotLevel;// SNAPSHOT_NONE, SNAPSHOT_FINAL or SNAPSHOT_ALL
+
+		//output buffers are vectors and keep their capacity between models.
+		//(pointers from getters are valid until the next genModel)
+		std::vector<size_t> constraints;// edges of the input polygon
+		std::vector<double> inputPoints;// the input polygon (for exportAsStroke)
+		polySnapshot snapshots[5];// 2D stages of genModel
+		std::vector<double> spines[2];
 		size_t spineNum[2];
 
-		double* points3D;//vertex coordinates of 3D model
-		size_t* faces;//face indices of 3D model
-		double* pointNormal;//vertex normal
+		//the 3D model is the +z half. the -z half is its mirror image (see getSeamPointNum)
+		std::vector<double> points3D;//vertex coordinates of 3D model
+		std::vector<size_t> faces;//face indices of 3D model
+		std::vector<double> pointNormal;//vertex normal
 
 		size_t point3DNum;//the number of vertices in 3D model
+		size_t seamPointNum;//the number of vertices on z=0
+		bool modelStored;//points3D, faces and pointNormal have the current model
 
-		//store 2d graph data
+		//store 2d graph data (if snapshotLevel needs the stage)
 		void store2DPolyData(size_t id);
 
-		//store 3D model data
+		//makes coordinates of edges of snapshots[id]
+		void materializeSnapshot(size_t id);
+
+		//store 3D model data (on the first access to them)
 		void storeModelData();
 
+		//makes .obj text of the model (with the -z half)
+		std::string objString();
+
+		//makes .stroke text of the input polygon
+		std::string strokeString(const char* desc);
+
+		//parses .stroke text and generates 3D model (throws graphException for format errors)
+		void genModelFromStroke(const std::string& str, int triangulator);
+
 	public:
-		poly_to_3D(graph::graph* graph);
+		poly_to_3D();
 		~poly_to_3D();
+
+		//handlers point to the graph in this object, so it can't be copied
+		poly_to_3D(const poly_to_3D&) = delete;
+		poly_to_3D& operator=(const poly_to_3D&) = delete;
 		void init();
 
 		//generate 3D model from 2D polygon
-		void genModel(double* point_coords, size_t pointNum);
+		//triangulator: TRIANGULATOR_CDT or TRIANGULATOR_EAR_CLIPPING
+		void genModel(double* point_coords, size_t pointNum, int triangulator = TRIANGULATOR_CDT);
+
+		//set the order to insert points in CDT (INSERTION_ORDER_INPUT or INSERTION_ORDER_BRIO)
+		void setInsertionOrder(int order);
+
+		//set the number of points inserted in each edge between spine and outline (1 or more, default 1)
+		//a cross section of the model will be a quarter ellipse with ringNum + 2 points.
+		void setRingNum(size_t num);
+
+		//set the 2D stages and spines genModel stores (SNAPSHOT_NONE, SNAPSHOT_FINAL or SNAPSHOT_ALL)
+		//getters return nullptr (and 0) for stages which are not stored
+		void setSnapshotLevel(int level);
+		int getSnapshotLevel();
 
 		//get spine data
 		void storeSpineData(size_t id);
@@ -64,22 +122,44 @@ namespace sketch3D {
 		double* getPointerToEdges(size_t id);
 		size_t getEdgeNum(size_t id);
 
-		//gets model datas
+		//gets model datas (the +z half of the model)
 		double* getPointerToPoints3D();
 		size_t getPoint3DNum();
 		size_t* getPointerToFaces();
 		size_t getFaceNum();
 		double* getPointerToPointNormal();
+
+		//the first getSeamPointNum() vertices are on z=0 and shared with the -z half.
+		//the -z half has vertices (x, y, -z) and faces (p2, p1, p3).
+		size_t getSeamPointNum();
+
+		//the number of vertices and faces writeModel writes (mirrored: with the -z half)
+		size_t getModelPointNum(bool mirrored);
+		size_t getModelFaceNum(bool mirrored);
+
+		//the number of predicate calls that needed exact arithmetic in the last genModel (for profiling)
+		size_t getExactPredicateNum();
+
+		//writes the model to caller's buffers without copies in this object (nullptr skips the buffer).
+		//point_coords and normals need getModelPointNum(mirrored) * 3 elements, face_IDs needs getModelFaceNum(mirrored) * 3.
+		//returns false if there is no model.
+		bool writeModel(float* point_coords, uint32_t* face_IDs, float* normals, bool mirrored);
 		
-		//export 3D model data as .obj
-		bool exportAsObj(WCHAR* FileName);
+		//export 3D model data as .obj (with the -z half)
+		bool exportAsObj(const char* file_path);
 
 		//export input polygon data
-		bool exportAsStroke(const WCHAR* file_path, const char* desc);
 		bool exportAsStroke(const char* file_path, const char* desc);
 
 		//import input polygon and generate 3D model
-		bool importStroke(const WCHAR* file_path);
+		bool importStroke(const char* file_path, int triangulator = TRIANGULATOR_CDT);
+
+#ifdef _WIN32
+		//WCHAR versions for paths from file dialogs
+		bool exportAsObj(WCHAR* FileName);
+		bool exportAsStroke(const WCHAR* file_path, const char* desc);
+		bool importStroke(const WCHAR* file_path, int triangulator = TRIANGULATOR_CDT);
+#endif
 
 		void loadGraph(const char* file_path);
 
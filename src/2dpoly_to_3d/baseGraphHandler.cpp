@@ -16,41 +16,27 @@ namespace sketch3D {
 
 
 	//constructor
-	baseGraphHandler::baseGraphHandler(graph::graph* graph, const char* classname){
+	baseGraphHandler::baseGraphHandler(graph::graph* graph, const char* classname) : constraintExist() {
 		directedGraph = graph;
 		className = classname;
+		exactNum = graph->getExactPredicateCounter();
 	}
 
 	//private
-	void baseGraphHandler::addPointObject(graph::point* p) {
-		directedGraph->addPointObject(p);
+	graph::pointIndex baseGraphHandler::addPoint(const graph::point& p) {
+		return directedGraph->addPoint(p);
 	}
 
-	graph::point* baseGraphHandler::getPoint(size_t index) {
-		return directedGraph->getPoint(index);
+	void baseGraphHandler::deleteEdgeFlagIsTrue(std::vector<graph::edgeIndex>* remap) {
+		directedGraph->deleteFlaggedEdges(remap);
 	}
 
-	graph::edge* baseGraphHandler::getEdge(size_t index) {
-		return directedGraph->getEdge(index);
-	}
-
-	void baseGraphHandler::deleteEdgeFlagIsTrue() {
-		size_t edge_size = getEdgeNum();
-		graph::edge* e;
-		for (int i = (int)edge_size - 1; i >= 0; i--) {
-			e = getEdge(i);
-			if (e->getFlag()) {
-				directedGraph->deleteEdge(i);
-			}
-		}
-	}
-
-	void baseGraphHandler::setFlagToFace(graph::edge* e) {
-		e->setFlag(true);
-		graph::edge* prev = e->getPrevEdge();
-		graph::edge* next = prev->getPrevEdge();
-		prev->setFlag(true);
-		next->setFlag(true);
+	void baseGraphHandler::setFlagToFace(graph::edgeIndex e) {
+		directedGraph->setFlag(e, true);
+		graph::edgeIndex prev = directedGraph->getPrevEdge(e);
+		graph::edgeIndex next = directedGraph->getPrevEdge(prev);
+		directedGraph->setFlag(prev, true);
+		directedGraph->setFlag(next, true);
 	}
 
 	void baseGraphHandler::init() {
@@ -61,34 +47,24 @@ namespace sketch3D {
 		directedGraph->getPointsEdgesAsCoords(point_coords, edge_coords);
 	}
 
-	size_t baseGraphHandler::getPointNum() {
-		return directedGraph->getPointNum();
-	}
-
-	size_t baseGraphHandler::getEdgeNum() {
-		return directedGraph->getEdgeNum();
-	}
-
 	void baseGraphHandler::checkAllConstraintEdgeExist(size_t pointNum, bool checkPair) {
-		bool* exist= new bool[pointNum];
-		for (size_t i = 0; i < pointNum; i++) {
-			exist[i] = false;
-		}
+		std::vector<bool>& exist = constraintExist;
+		exist.assign(pointNum, false);
 		size_t p1;
 		size_t p2;
-		graph::edge* e;
+		graph::edgeIndex e;
 		for (size_t i = 0; i < getEdgeNum(); i++) {
-			e = getEdge(i);
-			e->getPointID(&p1,&p2);
+			e = (graph::edgeIndex)i;
+			directedGraph->getPointID(e, &p1, &p2);
 			if ((p1 + 1) % pointNum == p2) {
 				exist[p1] = true;
-				if (checkPair && e->getPairEdge() != nullptr) {
+				if (checkPair && directedGraph->getPairEdge(e) != graph::NULL_EDGE) {
 					throw (graph::graphException(className, "checkAllConstraintEdgeExist: unexpected pair edge detected"));
 				}
 			}
 			if ((p2 + 1) % pointNum == p1) {
 				exist[p2] = true;
-				if (checkPair && e->getPairEdge() != nullptr) {
+				if (checkPair && directedGraph->getPairEdge(e) != graph::NULL_EDGE) {
 					throw (graph::graphException(className, "checkAllConstraintEdgeExist: unexpected pair edge detected"));
 				}
 			}
@@ -98,18 +74,16 @@ namespace sketch3D {
 				throw (graph::graphException(className, "checkAllConstraintEdgeExist: unexpected edge deletion detected"));
 			}
 		}
-		delete[] exist;
 	}
 
 	void baseGraphHandler::checkDuplicatePoint() {
 		size_t size = getPointNum();
-		graph::point* p1, * p2;
+		graph::point p1, p2;
 		for (size_t i = 0; i < size-1; i++) {
 			p1 = getPoint(i);
-			if (p1->getID() != i) printf("point Error!!!");
 			for (size_t j = i+1; i < size; i++) {
 				p2 = getPoint(j);
-				if (p1->getX() == p2->getX() && p1->getY() == p2->getY()) {
+				if (p1.getX() == p2.getX() && p1.getY() == p2.getY()) {
 					throw graph::graphException(className,"checkDuplicatePoint: duplicated point detected");
 				}
 			}
@@ -117,16 +91,14 @@ namespace sketch3D {
 	}
 	void baseGraphHandler::checkDuplicateEdge() {
 		size_t size = getEdgeNum();
-		graph::edge* e1, *e2;
+		graph::edgeIndex e1, e2;
 		size_t e1_p1, e1_p2, e2_p1, e2_p2;
 		for (size_t i = 0; i < size - 1; i++) {
-			e1 = getEdge(i);
-			e1_p1 = e1->getP1()->getID();
-			e1_p2 = e1->getP2()->getID();
+			e1 = (graph::edgeIndex)i;
+			directedGraph->getPointID(e1, &e1_p1, &e1_p2);
 			for (size_t j = i + 1; i < size; i++) {
-				e2 = getEdge(j);
-				e2_p1 = e2->getP1()->getID();
-				e2_p2 = e2->getP2()->getID();
+				e2 = (graph::edgeIndex)j;
+				directedGraph->getPointID(e2, &e2_p1, &e2_p2);
 				if (e1_p1 == e2_p1 && e1_p2 == e2_p2) {
 					throw graph::graphException(className, "checkDuplicateEdge: duplicated edge detected");
 				}
@@ -136,16 +108,14 @@ namespace sketch3D {
 
 	void baseGraphHandler::checkEdgePair() {
 		size_t size = getEdgeNum();
-		graph::edge* e1, * e2;
+		graph::edgeIndex e1, e2;
 		size_t e1_p1, e1_p2, e2_p1, e2_p2;
 		for (size_t i = 0; i < size; i++) {
-			e1 = getEdge(i);
-			e2 = e1->getPairEdge();
-			if (e2 != nullptr) {
-				e1_p1 = e1->getP1()->getID();
-				e1_p2 = e1->getP2()->getID();
-				e2_p1 = e2->getP1()->getID();
-				e2_p2 = e2->getP2()->getID();
+			e1 = (graph::edgeIndex)i;
+			e2 = directedGraph->getPairEdge(e1);
+			if (e2 != graph::NULL_EDGE) {
+				directedGraph->getPointID(e1, &e1_p1, &e1_p2);
+				directedGraph->getPointID(e2, &e2_p1, &e2_p2);
 				if (e1_p2 != e2_p1 || e1_p1 != e2_p2) {
 					printf("(%d,%d)<->(%d,%d)\n", (int)e1_p1,(int)e1_p2, (int)e2_p1, (int)e2_p2);
 					throw graph::graphException(className, "checkEdgePair: unexpected pair edge detected");
@@ -194,39 +164,20 @@ namespace sketch3D {
 	void baseGraphHandler::getFaces(size_t* face_IDs) {
 		size_t size = getPointNum();
 		if (size < 3) return;
-		directedGraph->resetFlag();
-		size = getEdgeNum();
-		graph::edge* e;
-		size_t count = 0;
+		size = directedGraph->getFaceNum();
+		graph::edgeIndex e;
 		size_t count3;
 		for (size_t i = 0; i < size; i++) {
-			e = getEdge(i);
-			if (!e->getFlag()) {
-				count3 = count * 3;
-				face_IDs[count3] = e->getP1()->getID();
-				face_IDs[count3 + 1] = e->getP2()->getID();
-				face_IDs[count3 + 2] = e->getP3()->getID();
-
-				count += 1;
-				setFlagToFace(e);
-			}
+			e = directedGraph->getFaceEdge(i);
+			count3 = i * 3;
+			face_IDs[count3] = directedGraph->getP1(e);
+			face_IDs[count3 + 1] = directedGraph->getP2(e);
+			face_IDs[count3 + 2] = directedGraph->getP3(e);
 		}
 	}
 
 	size_t baseGraphHandler::calFaceNum() {
-		directedGraph->resetFlag();
-		graph::edge* e;
-		size_t count = 0;
-		for (size_t i = 0; i < getEdgeNum(); i++) {
-			e = getEdge(i);
-			if (!e->getFlag()) {
-				count += 1;
-				e->setFlag(true);
-				e->getPrevEdge()->setFlag(true);
-				e->getPrevEdge()->getPrevEdge()->setFlag(true);
-			}
-		}
-		return count;
+		return directedGraph->getFaceNum();
 	}
 
 	std::string baseGraphHandler::graphToString() {
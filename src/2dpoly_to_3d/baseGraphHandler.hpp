@@ -22,22 +22,24 @@ namespace sketch3D {
 
 		const char* className;
 
+		size_t* exactNum;// the counter of exact predicate calls (owned by directedGraph)
+
+		std::vector<bool> constraintExist;// work buffer of checkAllConstraintEdgeExist (keeps its capacity)
+
 		//*private methods*
 
 		//add point p to graph
-		void addPointObject(graph::point* p);
+		graph::pointIndex addPoint(const graph::point& p);
 
-		//gets directedGraph.points[i]
-		graph::point* getPoint(size_t index);
-
-		//gets directedGraph.edges[i]
-		graph::edge* getEdge(size_t index);
+		//gets a copy of directedGraph.points[i]
+		graph::point getPoint(size_t index);
 
 		//delete edge flag is true
-		void deleteEdgeFlagIsTrue();
+		//remap[old index] = new index (NULL_EDGE for deleted edges) if remap is not nullptr
+		void deleteEdgeFlagIsTrue(std::vector<graph::edgeIndex>* remap = nullptr);
 
 		//set flag=true to e, e.prevE and e.prevE.prevE
-		void setFlagToFace(graph::edge* e);
+		void setFlagToFace(graph::edgeIndex e);
 		size_t calFaceNum();
 
 
@@ -73,4 +75,18 @@ namespace sketch3D {
 		//print graphToString();
 		void printGraph();
 	};
-}
\ No newline at end of file
+
+	//*inline accessors*
+
+	inline graph::point baseGraphHandler::getPoint(size_t index) {
+		return directedGraph->getPoint((graph::pointIndex)index);
+	}
+
+	inline size_t baseGraphHandler::getPointNum() {
+		return directedGraph->getPointNum();
+	}
+
+	inline size_t baseGraphHandler::getEdgeNum() {
+		return directedGraph->getEdgeNum();
+	}
+}
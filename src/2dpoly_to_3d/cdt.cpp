@@ -10,65 +10,362 @@
  */
 
 #include "cdt.hpp"
+#include "predicates.hpp"
 #include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <set>
 
 namespace sketch3D {
 	
 
 	//constructor
 	CDTsolver::CDTsolver(graph::graph* graph)
-		: baseGraphHandler(graph, "CDTsolver"), constEdges(), step(0), count(0) {}
+		: baseGraphHandler(graph, "CDTsolver"), constEdges(), constTable(), constTableMask(0), step(0), count(0), insertionOrder(INSERTION_ORDER_INPUT), pointEdge(),
+		edgeStack(), edgeQueue(), edgeQueueHead(0), crossingEdges(), pointOrder(), orderKeys(),
+		segmentLeft(), segmentRight(), sweepEvents(), sweepIters(), sweepArena(),
+		crossingConstraints(), errorMsg() {
+		crossingConstraints[0] = SIZE_MAX;
+		crossingConstraints[1] = SIZE_MAX;
+	}
 
 	//private
 
-	bool CDTsolver::isConstraint(graph::point* p1, graph::point* p2) {
-		graph::point* constP;
-		graph::point* constP2;
-		bool flag = false;
-		for (size_t i = 0; i < constEdges.size()/2; i++) {
-			constP = constEdges[i * 2];
-			constP2 = constEdges[i * 2 + 1];
-
-			if ((p1 == constP && p2 == constP2) || (p2 == constP && p1 == constP2)) {
-				flag = true;
-				break;
+	const uint64_t EMPTY_KEY = UINT64_MAX;
+
+	//key of edge p1-p2 (direction is ignored)
+	static inline uint64_t constraintKey(graph::pointIndex p1, graph::pointIndex p2) {
+		if (p1 > p2) return ((uint64_t)p2 << 32) | p1;
+		return ((uint64_t)p1 << 32) | p2;
+	}
+
+	static inline size_t constraintHash(uint64_t key) {
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		return (size_t)key;
+	}
+
+	void CDTsolver::buildConstraintTable() {
+		//load factor <= 0.5
+		size_t constNum = constEdges.size() / 2;
+		size_t size = 16;
+		while (size < constNum * 2) size *= 2;
+		constTable.assign(size, EMPTY_KEY);
+		constTableMask = size - 1;
+
+		uint64_t key;
+		size_t h;
+		for (size_t i = 0; i < constNum; i++) {
+			key = constraintKey(constEdges[i * 2], constEdges[i * 2 + 1]);
+			h = constraintHash(key) & constTableMask;
+			while (constTable[h] != EMPTY_KEY && constTable[h] != key) {
+				h = (h + 1) & constTableMask;
+			}
+			constTable[h] = key;
+		}
+	}
+
+	bool CDTsolver::isConstraint(graph::pointIndex p1, graph::pointIndex p2) {
+		if (constTable.empty()) return false;
+		uint64_t key = constraintKey(p1, p2);
+		size_t h = constraintHash(key) & constTableMask;
+
+		//linear probing
+		while (constTable[h] != EMPTY_KEY) {
+			if (constTable[h] == key) return true;
+			h = (h + 1) & constTableMask;
+		}
+		return false;
+	}
+
+	//a point (x, y) is less than (x', y') or not (sweep order)
+	static inline bool lexLess(const graph::point& a, const graph::point& b) {
+		return a.getX() < b.getX() || (a.getX() == b.getX() && a.getY() < b.getY());
+	}
+
+	//0: segments don't touch (or only share an end point)
+	//1: segments cross (isCross)
+	//2: segments touch (e.g. an end point is on the other segment, or they overlap)
+	static int intersectionType(const graph::point& a, const graph::point& b, const graph::point& c, const graph::point& d, size_t* exactNum) {
+		if (graph::isCross(a, b, c, d, exactNum)) return 1;
+		double o1 = graph::orient2D(b, c, a, exactNum);
+		double o2 = graph::orient2D(b, d, a, exactNum);
+		double o3 = graph::orient2D(d, a, c, exactNum);
+		double o4 = graph::orient2D(d, b, c, exactNum);
+		if (o1 * o2 > 0 || o3 * o4 > 0) return 0;
+
+		//a<b and c<d in sweep order
+		if (o1 == 0 && o2 == 0) {
+			//collinear
+			if (lexLess(c, b) && lexLess(a, d)) return 2;//overlap
+			return 0;
+		}
+		auto same = [](const graph::point& p, const graph::point& q) {
+			return p.getX() == q.getX() && p.getY() == q.getY();
+		};
+		if (same(a, c) || same(a, d) || same(b, c) || same(b, d)) return 0;
+		return 2;
+	}
+
+	//order of segments on the sweep line (from bottom to top)
+	//segments are compared at the later left end point, so the order is kept until segments cross.
+	bool CDTsolver::segmentLess::operator()(size_t s, size_t t) const {
+		const graph::point& sa = (*left)[s];
+		const graph::point& sb = (*right)[s];
+		const graph::point& ta = (*left)[t];
+		const graph::point& tb = (*right)[t];
+		double o;
+		if (lexLess(sa, ta)) {
+			//ta is above sa->sb then s<t
+			o = graph::orient2D(sb, ta, sa, exactNum);
+			if (o == 0) o = graph::orient2D(sb, tb, sa, exactNum);
+			if (o != 0) return o > 0;
+		}
+		else {
+			//sa is below ta->tb then s<t
+			o = graph::orient2D(tb, sa, ta, exactNum);
+			if (o == 0) o = graph::orient2D(tb, sb, ta, exactNum);
+			if (o != 0) return o < 0;
+		}
+		return s < t;//collinear
+	}
+
+	bool CDTsolver::findCrossingConstraints(size_t* constraints, size_t constNum, size_t* c1, size_t* c2) {
+		std::vector<graph::point>& left = segmentLeft;
+		std::vector<graph::point>& right = segmentRight;
+		left.resize(constNum);
+		right.resize(constNum);
+
+		//events (the sweep line moves from left to right)
+		//event = segment id * 2 + (0:remove, 1:insert). removes first at the same point.
+		std::vector<size_t>& events = sweepEvents;
+		events.clear();
+		graph::point p1, p2;
+		for (size_t i = 0; i < constNum; i++) {
+			p1 = getPoint(constraints[i * 2]);
+			p2 = getPoint(constraints[i * 2 + 1]);
+			if (lexLess(p2, p1)) std::swap(p1, p2);
+			left[i] = p1;
+			right[i] = p2;
+			if (!lexLess(p1, p2)) continue;//zero length segments never cross
+			events.push_back(i * 2);
+			events.push_back(i * 2 + 1);
+		}
+		auto eventPoint = [&left, &right](size_t ev) -> const graph::point& {
+			return (ev & 1) ? left[ev >> 1] : right[ev >> 1];
+		};
+		std::sort(events.begin(), events.end(), [&eventPoint](size_t a, size_t b) {
+			const graph::point& pa = eventPoint(a);
+			const graph::point& pb = eventPoint(b);
+			if (lexLess(pa, pb)) return true;
+			if (lexLess(pb, pa)) return false;
+			if ((a & 1) != (b & 1)) return (a & 1) < (b & 1);//removes first
+			return a < b;
+		});
+
+		sweepArena.reset();
+		sweepLine status(segmentLess{ &left, &right, exactNum }, arenaAllocator<size_t>(&sweepArena));
+		std::vector<sweepLine::iterator>& iters = sweepIters;
+		iters.resize(constNum);
+
+		//checks segments neighboring on the sweep line
+		//touching segments are invalid as well as crossing ones (they would break the order)
+		auto check = [&](size_t s, size_t t) {
+			if (intersectionType(left[s], right[s], left[t], right[t], exactNum) == 0) return false;
+			*c1 = (std::min)(s, t);
+			*c2 = (std::max)(s, t);
+			return true;
+		};
+
+		size_t s;
+		sweepLine::iterator it, above, below;
+		for (size_t i = 0; i < events.size(); i++) {
+			s = events[i] >> 1;
+			if (events[i] & 1) {
+				//insert
+				//never fails (segmentLess breaks ties by index)
+				it = status.insert(s).first;
+				iters[s] = it;
+				above = std::next(it);
+				if (above != status.end() && check(s, *above)) return true;
+				if (it != status.begin() && check(s, *std::prev(it))) return true;
+			}
+			else {
+				//remove
+				it = iters[s];
+				above = std::next(it);
+				if (it != status.begin() && above != status.end()) {
+					below = std::prev(it);
+					if (check(*below, *above)) return true;
+				}
+				status.erase(it);
 			}
 		}
-		return flag;
+		return false;
 	}
 
-	void CDTsolver::checkEdgeFlip(std::stack<graph::edge*>* edgeStack) {
-		graph::edge* e;
-		graph::edge* pair;
-		graph::point* p1;
-		graph::point* p2;
-		graph::point* p3;
-		graph::point* p4;
+	//index of (x, y) on a hilbert curve filling a (2^16)x(2^16) grid
+	static uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+		uint64_t d = 0;
+		uint32_t rx, ry, t;
+		for (uint32_t s = 1 << 15; s > 0; s >>= 1) {
+			rx = (x & s) > 0;
+			ry = (y & s) > 0;
+			d += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+			//rotate the quadrant
+			if (ry == 0) {
+				if (rx == 1) {
+					x = s - 1 - (x & (s - 1));
+					y = s - 1 - (y & (s - 1));
+				}
+				t = x;
+				x = y;
+				y = t;
+			}
+			x &= s - 1;
+			y &= s - 1;
+		}
+		return d;
+	}
+
+	void CDTsolver::getInsertionOrder() {
+		size_t pnum = getPointNum() - 3;//without the super triangle
+		pointOrder.resize(pnum);
+		for (size_t i = 0; i < pnum; i++) {
+			pointOrder[i] = (graph::pointIndex)i;
+		}
+		if (insertionOrder != INSERTION_ORDER_BRIO || pnum < 2) return;
+
+		//shuffles points with a fixed seed to get the same result for the same input
+		std::mt19937 rand(0x5eed);
+		std::shuffle(pointOrder.begin(), pointOrder.end(), rand);
+
+		double minX = directedGraph->getMinX();
+		double minY = directedGraph->getMinY();
+		double w = (std::max)(directedGraph->getMaxX() - minX, directedGraph->getMaxY() - minY);
+		double scale = w > 0 ? 65535.0 / w : 0;
+		orderKeys.resize(pnum);
+		for (size_t i = 0; i < pnum; i++) {
+			orderKeys[i] = hilbertIndex((uint32_t)((directedGraph->getX((graph::pointIndex)i) - minX) * scale),
+				(uint32_t)((directedGraph->getY((graph::pointIndex)i) - minY) * scale));
+		}
+
+		//rounds [0, pnum/2^k), ..., [pnum/4, pnum/2), [pnum/2, pnum)
+		//each round is sorted along the curve
+		size_t start;
+		size_t end = pnum;
+		while (end > 0) {
+			start = end > 64 ? end / 2 : 0;
+			std::sort(pointOrder.begin() + start, pointOrder.begin() + end,
+				[this](graph::pointIndex a, graph::pointIndex b) { return orderKeys[a] < orderKeys[b]; });
+			end = start;
+		}
+	}
+
+	void CDTsolver::flipEdge(graph::edgeIndex e, graph::edgeIndex pair, graph::edgeIndexStack* edgeStack) {
+		if (!pointEdge.empty()) {
+			//e=(p1,p2) and pair=(p2,p1) will be (p3,p4) and (p4,p3)
+			//p1 keeps pair.nextE=(p1,p4) and p2 keeps e.nextE=(p2,p3)
+			graph::pointIndex p1 = directedGraph->getP1(e);
+			graph::pointIndex p2 = directedGraph->getP1(pair);
+			if (pointEdge[p1] == e) pointEdge[p1] = directedGraph->getNextEdge(pair);
+			if (pointEdge[p2] == pair) pointEdge[p2] = directedGraph->getNextEdge(e);
+		}
+		directedGraph->flipEdge(e, pair, edgeStack);
+	}
+
+	void CDTsolver::buildPointEdge() {
+		pointEdge.assign(getPointNum(), graph::NULL_EDGE);
+		for (size_t i = 0; i < getEdgeNum(); i++) {
+			pointEdge[directedGraph->getP1((graph::edgeIndex)i)] = (graph::edgeIndex)i;
+		}
+	}
+
+	bool CDTsolver::findCrossingEdges(graph::pointIndex p1, graph::pointIndex p2, std::vector<graph::edgeIndex>& crossingEdges) {
+		crossingEdges.clear();
+		graph::point constP1 = getPoint(p1);
+		graph::point constP2 = getPoint(p2);
+
+		graph::edgeIndex start = pointEdge[p1];
+		if (start == graph::NULL_EDGE) return false;
+
+		//rotates around p1 to find the face p1->p2 goes through
+		graph::edgeIndex e = start;
+		graph::edgeIndex crossE = graph::NULL_EDGE;
+		graph::pointIndex p3, p4;
+		do {
+			p3 = directedGraph->getP2(e);
+			if (p3 == p2) return true;//edge p1->p2 already exists
+			p4 = directedGraph->getP3(e);
+			if (crossE == graph::NULL_EDGE && isCross(constP1, constP2, getPoint(p3), getPoint(p4), exactNum)) {
+				crossE = directedGraph->getNextEdge(e);
+			}
+			e = directedGraph->getPairEdge(directedGraph->getPrevEdge(e));
+			if (e == graph::NULL_EDGE) return false;//p1 is on the boundary
+		} while (e != start);
+		if (crossE == graph::NULL_EDGE) return false;//p1->p2 goes through a point
+
+		//walks faces along p1->p2
+		graph::edgeIndex pair;
+		graph::pointIndex p5;
+		size_t maxStep = getEdgeNum();
+		for (size_t step = 0; step < maxStep; step++) {
+			//an edge (p3,p4) crossing to p1->p2
+			p3 = directedGraph->getP1(crossE);
+			p4 = directedGraph->getP2(crossE);
+			pair = directedGraph->getPairEdge(crossE);
+			if (pair == graph::NULL_EDGE) return false;
+			crossingEdges.push_back(p3 < p4 ? crossE : pair);
+
+			//face (p4, p3, p5) on the other side
+			p5 = directedGraph->getP3(pair);
+			if (p5 == p2) return true;
+			if (isCross(constP1, constP2, getPoint(p3), getPoint(p5), exactNum)) {
+				crossE = directedGraph->getNextEdge(pair);//(p3,p5)
+			}
+			else if (isCross(constP1, constP2, getPoint(p5), getPoint(p4), exactNum)) {
+				crossE = directedGraph->getPrevEdge(pair);//(p5,p4)
+			}
+			else {
+				return false;//p1->p2 goes through p5
+			}
+		}
+		return false;
+	}
+
+	void CDTsolver::checkEdgeFlip(graph::edgeIndexStack* edgeStack) {
+		graph::edgeIndex e;
+		graph::edgeIndex pair;
+		graph::pointIndex p1_id, p2_id, p3_id, p4_id;
+		graph::point p1, p2, p3, p4;
 
 		while (!edgeStack->empty()) {
 			e = edgeStack->top();
 			edgeStack->pop();
-			pair = e->getPairEdge();
-			if (pair == nullptr) continue;
+			pair = directedGraph->getPairEdge(e);
+			if (pair == graph::NULL_EDGE) continue;
 
-			p1 = e->getP1();
-			p2 = e->getP2();
+			p1_id = directedGraph->getP1(e);
+			p2_id = directedGraph->getP2(e);
 
-			if (isConstraint(p1, p2)) continue;
+			if (isConstraint(p1_id, p2_id)) continue;
 
-			p3 = e->getP3();
-			p4 = pair->getP3();
+			p3_id = directedGraph->getP3(e);
+			p4_id = directedGraph->getP3(pair);
+			p1 = getPoint(p1_id);
+			p2 = getPoint(p2_id);
+			p3 = getPoint(p3_id);
+			p4 = getPoint(p4_id);
 
-			if (isConstraint(p3, p4) && isConvexSquare(p1, p2, p3, p4)) {
-				directedGraph->flipEdge(e, pair, p3, p4, edgeStack);
+			if (isConstraint(p3_id, p4_id) && isConvexSquare(p1, p2, p3, p4, exactNum)) {
+				flipEdge(e, pair, edgeStack);
 				continue;
 			}
 
-			//if det>0 then p4 is in a circumscribed circle
-			double det = crossprod2D(p1, p2, p4) * squaredDistance(p3, p4)
-				+ crossprod2D(p3, p1, p4) * squaredDistance(p2, p4)
-				+ crossprod2D(p2, p3, p4) * squaredDistance(p1, p4);
-			if (det > 0) directedGraph->flipEdge(e, pair, p3, p4, edgeStack);
+			//if p4 is in a circumscribed circle then flip
+			if (inCircle(p1, p2, p3, p4, exactNum) > 0) flipEdge(e, pair, edgeStack);
 		}
 	}
 
@@ -80,36 +377,37 @@ namespace sketch3D {
 
 		double w = maxX - minX;
 		double h = maxY - minY;
+
+		//keeps the triangle from being flat when points are (almost) on a horizontal or vertical line
+		double size = (std::max)(w, h);
+		if (!(size > 0)) size = 1;
+		w = (std::max)(w, size * 0.1);
+		h = (std::max)(h, size * 0.1);
 		size_t pnum = getPointNum();
 
-		directedGraph->addPoint(minX - w * 0.1, minY + h * 2.1);
+		//(maxX, maxY) should be strictly inside the triangle
+		directedGraph->addPoint(minX - w * 0.1, minY + h * 3.1);
 		directedGraph->addPoint(minX - w * 0.1, minY - h * 0.1);
-		directedGraph->addPoint(minX + w * 2.1, minY - h * 0.1);
-
-		directedGraph->addEdge(pnum, pnum + 1);
-		directedGraph->addEdge(pnum + 1, pnum + 2);
-		directedGraph->addEdge(pnum + 2, pnum);
-		directedGraph->setPrevEdge(0, 2);
-		directedGraph->setPrevEdge(1, 0);
-		directedGraph->setPrevEdge(2, 1);
+		directedGraph->addPoint(minX + w * 3.1, minY - h * 0.1);
+
+		directedGraph->addFace(pnum, pnum + 1, pnum + 2);
 	}
 
 
 	void CDTsolver::deleteSuperTriangle() {
 
-		std::stack<size_t> deteleEdgeID;
 		bool delete_flag;
 		size_t p1_id = 0, p2_id = 0;
 		size_t edge_size = getEdgeNum();
 		size_t point_size = getPointNum();
-		graph::edge* e;
+		graph::edgeIndex e;
 
 		directedGraph->resetFlag();
 		for (size_t i = 0; i < edge_size; i++) {
-			e = getEdge(i);
-			delete_flag = e->getFlag();
+			e = (graph::edgeIndex)i;
+			delete_flag = directedGraph->getFlag(e);
 			if (delete_flag) continue;
-			e->getPointID(&p1_id, &p2_id);
+			directedGraph->getPointID(e, &p1_id, &p2_id);
 			if (p1_id >= point_size - 3 || p2_id >= point_size - 3) {
 				setFlagToFace(e);
 			}
@@ -120,42 +418,53 @@ namespace sketch3D {
 		directedGraph->deleteLastPoint(3);
 	}
 
-	void CDTsolver::checkConstraint(graph::point* p1, graph::point* p2, std::queue<graph::edge*>* edgeQueue) {
-		graph::point* p3;
-		graph::point* p4;
-		graph::edge* e;
+	void CDTsolver::checkConstraint(graph::pointIndex p1, graph::pointIndex p2) {
+		graph::pointIndex p3;
+		graph::pointIndex p4;
+		graph::point constP1 = getPoint(p1);
+		graph::point constP2 = getPoint(p2);
+
+		//walks from p1 to p2. edges are pushed in index order as well as the global scan.
+		crossingEdges.clear();
+		if (findCrossingEdges(p1, p2, crossingEdges)) {
+			std::sort(crossingEdges.begin(), crossingEdges.end());
+			edgeQueue.insert(edgeQueue.end(), crossingEdges.begin(), crossingEdges.end());
+			return;
+		}
 
+		//degenerate case. checks all edges.
 		for (size_t i = 0; i < getEdgeNum(); i++) {
-			e = getEdge(i);
-			p3 = e->getP1();
-			p4 = e->getP2();
-			if (p3->getID() > p4->getID()) continue;
+			p3 = directedGraph->getP1((graph::edgeIndex)i);
+			p4 = directedGraph->getP2((graph::edgeIndex)i);
+			if (p3 > p4) continue;
 
-			if (isCross(p1,p2,p3,p4)) edgeQueue->push(e);
+			if (isCross(constP1, constP2, getPoint(p3), getPoint(p4), exactNum)) edgeQueue.push_back((graph::edgeIndex)i);
 		}
 	}
 	
-	void CDTsolver::restoreConstraint(graph::point* constP1, graph::point* constP2, graph::edge* e, std::queue<graph::edge*>* edgeQueue, std::stack<graph::edge*>* edgeStack) {
-		graph::edge* pair = e->getPairEdge();
-		if (pair == nullptr) return;
+	void CDTsolver::restoreConstraint(graph::pointIndex constP1, graph::pointIndex constP2, graph::edgeIndex e) {
+		graph::edgeIndex pair = directedGraph->getPairEdge(e);
+		if (pair == graph::NULL_EDGE) return;
 
-		graph::point* p1 = e->getP1();
-		graph::point* p2 = e->getP2();
+		graph::pointIndex p1_id = directedGraph->getP1(e);
+		graph::pointIndex p2_id = directedGraph->getP2(e);
 
-		if (isConstraint(p1, p2)) return;
+		if (isConstraint(p1_id, p2_id)) return;
 
-		graph::point* p3 = e->getP3();
-		graph::point* p4 = pair->getP3();
+		graph::point p1 = getPoint(p1_id);
+		graph::point p2 = getPoint(p2_id);
+		graph::point p3 = getPoint(directedGraph->getP3(e));
+		graph::point p4 = getPoint(directedGraph->getP3(pair));
 
-		if (isConvexSquare(p1, p2, p3, p4)) {
-			directedGraph->flipEdge(e, pair, p3, p4);
-			if (isCross(constP1, constP2, p3, p4)) {
-				edgeQueue->push(e);
+		if (isConvexSquare(p1, p2, p3, p4, exactNum)) {
+			flipEdge(e, pair);
+			if (isCross(getPoint(constP1), getPoint(constP2), p3, p4, exactNum)) {
+				edgeQueue.push_back(e);
 			}
-			else { edgeStack->push(e); count = 0; }
+			else { edgeStack.push(e); count = 0; }
 		}
 		else {
-			edgeQueue->push(e);
+			edgeQueue.push_back(e);
 		}
 	}
 
@@ -169,25 +478,21 @@ namespace sketch3D {
 		if (constraints == nullptr) return;
 
 		//checks constraints
-		graph::point* p1, * p2, * p3, * p4;
-		for (size_t i = 0; i < constNum - 1; i++) {
-			p1 = getPoint(constraints[i * 2]);
-			p2 = getPoint(constraints[i * 2 + 1]);
-			for (size_t j = i + 1; j < constNum; j++) {
-				p3 = getPoint(constraints[j * 2]);
-				p4 = getPoint(constraints[j * 2 + 1]);
-				if (isCross(p1, p2, p3, p4)) {
-					step = 1;
-					throw(graph::graphException("CDTsolver", "defineProblem : invalid constraints", false));
-				}
-			}
+		size_t c1, c2;
+		if (findCrossingConstraints(constraints, constNum, &c1, &c2)) {
+			step = 1;
+			crossingConstraints[0] = c1;
+			crossingConstraints[1] = c2;
+			snprintf(errorMsg, sizeof(errorMsg), "defineProblem : invalid constraints (constraint %zu crosses or touches constraint %zu)", c1, c2);
+			throw(graph::graphException("CDTsolver", errorMsg, false));
 		}
 
 		//defines constraints
 		constEdges.resize(constNum * 2);
 		for (size_t i = 0; i < constNum * 2; i++) {
-			constEdges[i] = getPoint(constraints[i]);
+			constEdges[i] = (graph::pointIndex)constraints[i];
 		}
+		buildConstraintTable();
 		for (size_t i = 0; i < constNum; i++) {
 			directedGraph->addEdge(constraints[i*2], constraints[i*2+1]);
 		}
@@ -195,10 +500,7 @@ namespace sketch3D {
 	}
 
 	void CDTsolver::deleteAllEdges() {
-		size_t size = getEdgeNum();
-		for (size_t i = 0; i < size; i++) {
-			directedGraph->deleteEdge(0);
-		}
+		directedGraph->clearEdges();
 	}
 
 	void CDTsolver::solve() {
@@ -210,48 +512,73 @@ namespace sketch3D {
 		addSuperTriangle();
 
 		bool inserted;
-		std::stack<graph::edge*>* edgeStack = new std::stack<graph::edge*>();
-		graph::edge* top;
+		graph::edgeIndex top;
+		while (!edgeStack.empty()) edgeStack.pop();//left by an exception
+
+		getInsertionOrder();
 
 		//insert points
-		for (size_t i = 0; i < getPointNum()-3; i++) {
+		for (size_t i = 0; i < pointOrder.size(); i++) {
 			//insert a point
-			inserted = directedGraph->findFaceIncludePoint(getPoint(i), getEdge(getEdgeNum() - 1), edgeStack = edgeStack);
+			//the walk starts from the last edge. it's a new edge made by the previous insertion and
+			//legalization never flips it, so it's still incident to the previous point.
+			inserted = directedGraph->findFaceIncludePoint(pointOrder[i], (graph::edgeIndex)(getEdgeNum() - 1), &edgeStack);
 			if (!inserted) throw graph::graphException("CDTsolver","solve: failed with point insertion");
 
 			//flip edges to meet delaunay properties
-			checkEdgeFlip(edgeStack);					
+			checkEdgeFlip(&edgeStack);
 		}
 
-		std::queue<graph::edge*>* edgeQueue = new std::queue<graph::edge*>();
-		graph::point* p1, * p2;
+		graph::pointIndex p1, p2;
+		buildPointEdge();
 		//flip edges to meet constraints
 		for (size_t i = 0; i < constEdges.size() / 2; i++) {
 			p1 = constEdges[i * 2];
 			p2 = constEdges[i * 2 + 1];
 
 			//get edges cross to edge p1->p2
-			checkConstraint(p1, p2, edgeQueue);
+			edgeQueue.clear();
+			edgeQueueHead = 0;
+			checkConstraint(p1, p2);
 
 			//flip edges to restore edge p1->p2
-			while (!edgeQueue->empty()) {
-				top = edgeQueue->front();
-				edgeQueue->pop();
-				restoreConstraint(p1,p2,top, edgeQueue, edgeStack);
+			while (edgeQueueHead < edgeQueue.size()) {
+				top = edgeQueue[edgeQueueHead];
+				edgeQueueHead++;
+				restoreConstraint(p1, p2, top);
+
+				//drops popped edges, so the queue doesn't grow while edges go around
+				if (edgeQueueHead > 1024 && edgeQueueHead * 2 > edgeQueue.size()) {
+					edgeQueue.erase(edgeQueue.begin(), edgeQueue.begin() + edgeQueueHead);
+					edgeQueueHead = 0;
+				}
 			}
 
 			//flip edges to meet delaunay properties
-			checkEdgeFlip(edgeStack);
+			checkEdgeFlip(&edgeStack);
 		}
-		delete edgeStack;
-		delete edgeQueue;
+		pointEdge.clear();
 
 		deleteSuperTriangle();
 	}
 
+	bool CDTsolver::getCrossingConstraints(size_t* c1, size_t* c2) {
+		if (crossingConstraints[0] == SIZE_MAX) return false;
+		*c1 = crossingConstraints[0];
+		*c2 = crossingConstraints[1];
+		return true;
+	}
+
+	void CDTsolver::setInsertionOrder(int order) {
+		insertionOrder = order;
+	}
+
 	void CDTsolver::init() {
-		constEdges.resize(0);
-		constEdges.shrink_to_fit();
+		constEdges.clear();
+		constTable.clear();
+		constTableMask = 0;
+		crossingConstraints[0] = SIZE_MAX;
+		crossingConstraints[1] = SIZE_MAX;
 		step = 1;
 		count = 0;
 	}
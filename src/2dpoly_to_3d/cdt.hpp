@@ -12,35 +12,85 @@
 #pragma once
 
 #include "baseGraphHandler.hpp"
-#include <queue>
+#include "pool.hpp"
+#include <set>
 //#include "exception.h"
 //#include "point.h"
 //#include "edge.h"
 //#include "graph.hpp"
 
 namespace sketch3D {
+
+	const int INSERTION_ORDER_INPUT = 0;// inserts points in input order
+	const int INSERTION_ORDER_BRIO = 1;// biased randomized insertion order (rounds sorted along a hilbert curve)
+
 	class CDTsolver : public baseGraphHandler {
 	private:
+		//order of constraints on the sweep line of findCrossingConstraints
+		struct segmentLess {
+			const std::vector<graph::point>* left;
+			const std::vector<graph::point>* right;
+			size_t* exactNum;
+			bool operator()(size_t s, size_t t) const;
+		};
+		typedef std::set<size_t, segmentLess, arenaAllocator<size_t>> sweepLine;
+
 	  //*parameters*
 
 		//graph::graph* directedGraph;// a graph object for CDT
-		std::vector<graph::point*> constEdges; // constraints as an array of points {e1_p1, e1_p2, e2_p1, ...}
+		std::vector<graph::pointIndex> constEdges; // constraints as an array of point indices {e1_p1, e1_p2, e2_p1, ...}
+		std::vector<uint64_t> constTable; // hash set of constraints (open addressing). a key is (min point id << 32 | max point id)
+		size_t constTableMask; // constTable.size() - 1
 		int step;// 0:initialized, 1:defined a problem, 2:solved
 		int count;
+		int insertionOrder;// INSERTION_ORDER_INPUT or INSERTION_ORDER_BRIO
+		std::vector<graph::edgeIndex> pointEdge;// an edge starts from each point (used for constraint recovery)
+
+		//work buffers (they keep their capacity between problems)
+		graph::edgeIndexStack edgeStack;// edges to check delaunay properties
+		std::vector<graph::edgeIndex> edgeQueue;// edges crossing a constraint (a queue from edgeQueue[edgeQueueHead])
+		size_t edgeQueueHead;
+		std::vector<graph::edgeIndex> crossingEdges;
+		std::vector<graph::pointIndex> pointOrder;// insertion order of points
+		std::vector<uint64_t> orderKeys;
+		std::vector<graph::point> segmentLeft;// end points of constraints in sweep order (used by findCrossingConstraints)
+		std::vector<graph::point> segmentRight;
+		std::vector<size_t> sweepEvents;
+		std::vector<sweepLine::iterator> sweepIters;// positions of constraints on the sweep line
+		arena sweepArena;// nodes of the sweep line
+		size_t crossingConstraints[2];// a pair of constraints found by defineProblem (crossing or touching each other)
+		char errorMsg[160];// message for graphException
 
 	  //*private methods*
 
 		//gets directedGraph.points[i]
-		//graph::point* getPoint(size_t index);
+		//graph::point getPoint(size_t index);
+
+		//makes a hash set from constEdges
+		void buildConstraintTable();
 
-		//gets directedGraph.edges[i]
-		//graph::edge* getEdge(size_t index);
+		//finds a pair of constraints crossing or touching each other by a sweep line (Shamos-Hoey)
+		//returns false if there is no pair
+		bool findCrossingConstraints(size_t* constraints, size_t constNum, size_t* c1, size_t* c2);
 
 		//edge p1->p2 is a constraint edge or not
-		bool isConstraint(graph::point* p1, graph::point* p2);
+		bool isConstraint(graph::pointIndex p1, graph::pointIndex p2);
+
+		//gets the order to insert points
+		void getInsertionOrder();
+
+		//flips edge e and keeps pointEdge valid
+		void flipEdge(graph::edgeIndex e, graph::edgeIndex pair, graph::edgeIndexStack* edgeStack = nullptr);
+
+		//makes pointEdge from the graph
+		void buildPointEdge();
+
+		//finds edges cross to edge p1->p2 by walking triangles around p1 along p1->p2
+		//returns false when the walk hits a degenerate case
+		bool findCrossingEdges(graph::pointIndex p1, graph::pointIndex p2, std::vector<graph::edgeIndex>& crossingEdges);
 
 		//checks delaunay constraints
-		void checkEdgeFlip(std::stack<graph::edge*>* edgeStack);
+		void checkEdgeFlip(graph::edgeIndexStack* edgeStack);
 		
 		void deleteAllEdges();
 
@@ -50,9 +100,11 @@ namespace sketch3D {
 		//deletes the super triangle from graph
 		void deleteSuperTriangle();
 
-		void checkConstraint(graph::point* p1, graph::point* p2, std::queue<graph::edge*>* edgeQueue);
+		//pushes edges cross to edge p1->p2 to edgeQueue
+		void checkConstraint(graph::pointIndex p1, graph::pointIndex p2);
 
-		void restoreConstraint(graph::point* constP1, graph::point* constP2, graph::edge* e, std::queue<graph::edge*>* edgeQueue, std::stack<graph::edge*>* edgeStack);
+		//flips edge e if it can. pushes e to edgeQueue again if it still crosses the constraint.
+		void restoreConstraint(graph::pointIndex constP1, graph::pointIndex constP2, graph::edgeIndex e);
 
 	public:
 		/*
@@ -85,6 +137,29 @@ namespace sketch3D {
 		*/
 		void solve();
 
+		/*
+		* Method: setInsertionOrder
+		* Usage: cdt.setInsertionOrder(INSERTION_ORDER_BRIO);
+		* ---------------------------------
+		* Sets the order to insert points in solve().
+		* INSERTION_ORDER_INPUT : input order (default)
+		* INSERTION_ORDER_BRIO : biased randomized insertion order.
+		*     Points are shuffled into rounds (each round doubles in size),
+		*     and each round is sorted along a hilbert curve.
+		*     Point location becomes O(1) on average for dense point sets.
+		*/
+		void setInsertionOrder(int order);
+
+		/*
+		* Method: getCrossingConstraints
+		* Usage: cdt.getCrossingConstraints(&c1, &c2);
+		* ---------------------------------
+		* Gets indices of constraints crossing or touching each other.
+		* defineProblem() finds them when it throws an "invalid constraints" exception.
+		* Returns false if defineProblem() didn't find them.
+		*/
+		bool getCrossingConstraints(size_t* c1, size_t* c2);
+
 		/*
 		* Method: init
 		* Usage: cdt.init();
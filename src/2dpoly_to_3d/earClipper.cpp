@@ -0,0 +1,238 @@
+/*
+ * File: earClipper.cpp
+ * --------------------
+ * This file contains the implementation of ear clipping triangulator.
+ *
+ * See earClipper.hpp for documentation of each member.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#include "earClipper.hpp"
+#include "predicates.hpp"
+#include <algorithm>
+
+namespace sketch3D {
+
+	earClipper::earClipper(graph::graph* graph)
+		: baseGraphHandler(graph, "earClipper"),
+		prevV(), nextV(), zOrder(), prevZ(), nextZ(),
+		minX(0), minY(0), invSize(0),
+		zSorted(), triangles(), edgeStack() {}
+
+	void earClipper::init() {
+		prevV.clear();
+		nextV.clear();
+		zOrder.clear();
+		prevZ.clear();
+		nextZ.clear();
+		zSorted.clear();
+		triangles.clear();
+		while (!edgeStack.empty()) edgeStack.pop();
+	}
+
+	//private
+
+	double earClipper::cross(graph::pointIndex a, graph::pointIndex b, graph::pointIndex c) {
+		return graph::orient2D(getPoint(a), getPoint(b), getPoint(c), exactNum);
+	}
+
+	uint32_t earClipper::calZOrder(double x, double y) {
+		//coords are transformed into non-negative 15 bit integer range
+		uint32_t ix = (uint32_t)((x - minX) * invSize);
+		uint32_t iy = (uint32_t)((y - minY) * invSize);
+
+		ix = (ix | (ix << 8)) & 0x00FF00FF;
+		ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+		ix = (ix | (ix << 2)) & 0x33333333;
+		ix = (ix | (ix << 1)) & 0x55555555;
+
+		iy = (iy | (iy << 8)) & 0x00FF00FF;
+		iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+		iy = (iy | (iy << 2)) & 0x33333333;
+		iy = (iy | (iy << 1)) & 0x55555555;
+
+		return ix | (iy << 1);
+	}
+
+	void earClipper::initList(size_t pointNum) {
+		prevV.resize(pointNum);
+		nextV.resize(pointNum);
+		zOrder.resize(pointNum);
+		prevZ.resize(pointNum);
+		nextZ.resize(pointNum);
+
+		//orientation of the polygon
+		double area = 0;
+		double maxX, maxY, x, y;
+		minX = maxX = directedGraph->getX(0);
+		minY = maxY = directedGraph->getY(0);
+		for (size_t i = 0; i < pointNum; i++) {
+			graph::pointIndex j = (graph::pointIndex)((i + 1) % pointNum);
+			x = directedGraph->getX((graph::pointIndex)i);
+			y = directedGraph->getY((graph::pointIndex)i);
+			area += x * directedGraph->getY(j) - directedGraph->getX(j) * y;
+			minX = (std::min)(minX, x);
+			minY = (std::min)(minY, y);
+			maxX = (std::max)(maxX, x);
+			maxY = (std::max)(maxY, y);
+		}
+
+		//makes the list counterclockwise
+		bool ccw = area > 0;
+		for (size_t i = 0; i < pointNum; i++) {
+			graph::pointIndex p = (graph::pointIndex)((i + pointNum - 1) % pointNum);
+			graph::pointIndex n = (graph::pointIndex)((i + 1) % pointNum);
+			prevV[i] = ccw ? p : n;
+			nextV[i] = ccw ? n : p;
+		}
+
+		//sorts vertices by z-order
+		double size = (std::max)(maxX - minX, maxY - minY);
+		invSize = size > 0 ? 32767.0 / size : 0;
+		zSorted.resize(pointNum);
+		for (size_t i = 0; i < pointNum; i++) {
+			zOrder[i] = calZOrder(directedGraph->getX((graph::pointIndex)i), directedGraph->getY((graph::pointIndex)i));
+			zSorted[i] = (graph::pointIndex)i;
+		}
+		std::sort(zSorted.begin(), zSorted.end(),
+			[this](graph::pointIndex a, graph::pointIndex b) { return zOrder[a] < zOrder[b]; });
+		for (size_t i = 0; i < pointNum; i++) {
+			prevZ[zSorted[i]] = i > 0 ? zSorted[i - 1] : graph::NULL_POINT;
+			nextZ[zSorted[i]] = i + 1 < pointNum ? zSorted[i + 1] : graph::NULL_POINT;
+		}
+	}
+
+	bool earClipper::isEar(graph::pointIndex ear) {
+		graph::pointIndex a = prevV[ear];
+		graph::pointIndex b = ear;
+		graph::pointIndex c = nextV[ear];
+
+		//reflex
+		if (cross(a, b, c) <= 0) return false;
+
+		graph::point pa = getPoint(a);
+		graph::point pb = getPoint(b);
+		graph::point pc = getPoint(c);
+
+		//z-order range of the triangle
+		uint32_t minZ = calZOrder((std::min)({ pa.getX(), pb.getX(), pc.getX() }), (std::min)({ pa.getY(), pb.getY(), pc.getY() }));
+		uint32_t maxZ = calZOrder((std::max)({ pa.getX(), pb.getX(), pc.getX() }), (std::max)({ pa.getY(), pb.getY(), pc.getY() }));
+
+		//a reflex vertex in the triangle makes it not an ear
+		auto blocks = [&](graph::pointIndex p) {
+			if (p == a || p == c) return false;
+			graph::point pp = getPoint(p);
+			if (graph::orient2D(pa, pb, pp, exactNum) < 0 || graph::orient2D(pb, pc, pp, exactNum) < 0 || graph::orient2D(pc, pa, pp, exactNum) < 0) return false;
+			return cross(prevV[p], p, nextV[p]) <= 0;
+		};
+
+		graph::pointIndex p = nextZ[ear];
+		while (p != graph::NULL_POINT && zOrder[p] <= maxZ) {
+			if (blocks(p)) return false;
+			p = nextZ[p];
+		}
+		p = prevZ[ear];
+		while (p != graph::NULL_POINT && zOrder[p] >= minZ) {
+			if (blocks(p)) return false;
+			p = prevZ[p];
+		}
+		return true;
+	}
+
+	void earClipper::removeVertex(graph::pointIndex v) {
+		nextV[prevV[v]] = nextV[v];
+		prevV[nextV[v]] = prevV[v];
+		if (prevZ[v] != graph::NULL_POINT) nextZ[prevZ[v]] = nextZ[v];
+		if (nextZ[v] != graph::NULL_POINT) prevZ[nextZ[v]] = prevZ[v];
+	}
+
+	void earClipper::flipToDelaunay() {
+		graph::edgeIndex pair;
+		for (size_t i = 0; i < getEdgeNum(); i++) {
+			pair = directedGraph->getPairEdge((graph::edgeIndex)i);
+			if (pair != graph::NULL_EDGE && i < pair) edgeStack.push((graph::edgeIndex)i);
+		}
+
+		graph::edgeIndex e, prevE, nextE;
+		graph::point p1, p2, p3, p4;
+		//predicates are exact, so flips never loop. too many flips means a bug.
+		size_t maxFlip = getEdgeNum() * 32;
+		size_t flipNum = 0;
+		while (!edgeStack.empty()) {
+			e = edgeStack.top();
+			edgeStack.pop();
+			pair = directedGraph->getPairEdge(e);
+			if (pair == graph::NULL_EDGE) continue;//outer edge
+
+			p1 = getPoint(directedGraph->getP1(e));
+			p2 = getPoint(directedGraph->getP2(e));
+			p3 = getPoint(directedGraph->getP3(e));
+			p4 = getPoint(directedGraph->getP3(pair));
+
+			//can't flip a concave square
+			if (!graph::isCross(p1, p2, p3, p4, exactNum)) continue;
+
+			//flips if p4 is in a circumscribed circle
+			if (graph::inCircle(p1, p2, p3, p4, exactNum) <= 0) continue;
+
+			prevE = directedGraph->getPrevEdge(e);
+			nextE = directedGraph->getNextEdge(e);
+			edgeStack.push(prevE);
+			edgeStack.push(nextE);
+			directedGraph->flipEdge(e, pair, &edgeStack);
+			flipNum++;
+			if (flipNum > maxFlip) throw graph::graphException("earClipper", "flipToDelaunay: too many flips (the triangulation may not be delaunay)");
+		}
+	}
+
+	//public
+
+	void earClipper::solve(size_t pointNum) {
+		if (pointNum < 3) throw graph::graphException("earClipper", "solve: 'pointNum' should be more equal than 3");
+		directedGraph->clearEdges();
+		initList(pointNum);
+
+		//clips ears
+		triangles.clear();
+		triangles.reserve((pointNum - 2) * 3);
+		graph::pointIndex ear = 0;
+		graph::pointIndex next;
+		size_t vertexNum = pointNum;
+		size_t failNum = 0;
+		while (vertexNum > 3) {
+			if (isEar(ear)) {
+				triangles.push_back(prevV[ear]);
+				triangles.push_back(ear);
+				triangles.push_back(nextV[ear]);
+				next = nextV[ear];
+				removeVertex(ear);
+				vertexNum--;
+				failNum = 0;
+
+				//skipping the next vertex makes thin triangles less
+				ear = nextV[next];
+				continue;
+			}
+			ear = nextV[ear];
+			failNum++;
+			if (failNum > vertexNum) {
+				throw graph::graphException("earClipper", "solve: failed to find an ear (degenerate polygon)", false);
+			}
+		}
+		triangles.push_back(prevV[ear]);
+		triangles.push_back(ear);
+		triangles.push_back(nextV[ear]);
+
+		//makes faces and pairs of edges
+		size_t faceNum = triangles.size() / 3;
+		for (size_t i = 0; i < faceNum; i++) {
+			directedGraph->addFace(triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2]);
+		}
+		directedGraph->makePairs();
+
+		flipToDelaunay();
+		init();
+	}
+}
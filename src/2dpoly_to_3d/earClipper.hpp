@@ -0,0 +1,83 @@
+/*
+ * File: earClipper.hpp
+ * --------------------
+ * This file contains the declaration of ear clipping triangulator.
+ *
+ * It triangulates a simple polygon without a super triangle,
+ * and flips edges to meet delaunay properties (Lawson's algorithm).
+ * The result is the same graph as CDTsolver + spineEstimator::deleteExternalEdge.
+ *
+ * See earClipper.cpp for implementation of each member.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#pragma once
+
+#include "baseGraphHandler.hpp"
+
+namespace sketch3D {
+
+	class earClipper : public baseGraphHandler {
+	private:
+		//*parameters*
+
+		//vertices of the polygon as a doubly linked list (counterclockwise)
+		std::vector<graph::pointIndex> prevV;
+		std::vector<graph::pointIndex> nextV;
+
+		//vertices as a doubly linked list sorted by z-order (to find points in a triangle)
+		std::vector<uint32_t> zOrder;
+		std::vector<graph::pointIndex> prevZ;
+		std::vector<graph::pointIndex> nextZ;
+
+		double minX, minY, invSize;// to calculate z-order
+
+		//work buffers (they keep their capacity between problems)
+		std::vector<graph::pointIndex> zSorted;// vertices sorted by z-order
+		std::vector<graph::pointIndex> triangles;// clipped ears
+		graph::edgeIndexStack edgeStack;
+
+		//*private methods*
+
+		//c->a X c->b for points[a], points[b] and points[c]
+		double cross(graph::pointIndex a, graph::pointIndex b, graph::pointIndex c);
+
+		//makes linked lists of the polygon
+		void initList(size_t pointNum);
+
+		//z-order of point (x, y)
+		uint32_t calZOrder(double x, double y);
+
+		//triangle prev->ear->next is an ear or not
+		bool isEar(graph::pointIndex ear);
+
+		//removes vertex v from linked lists
+		void removeVertex(graph::pointIndex v);
+
+		//flips edges to meet delaunay properties
+		void flipToDelaunay();
+
+	public:
+		/*
+		* Constructor: earClipper
+		* Usage: earClipper ec(graph);
+		* ---------------------------------
+		* graph: a directed graph object
+		*/
+		earClipper(graph::graph* graph);
+
+		/*
+		* Method: solve
+		* Usage: ec.solve(pointNum);
+		* ---------------------------------
+		* Triangulates the polygon points[0]->points[1]->...->points[pointNum-1]->points[0].
+		* The polygon should be simple (CDTsolver::defineProblem checks it).
+		* Edges in the graph will be deleted.
+		*/
+		void solve(size_t pointNum);
+
+		void init() override;
+	};
+}
@@ -11,32 +11,39 @@
  */
 
 #include "graph.hpp"
+#include "predicates.hpp"
 #include <cmath>
+#include <cfloat>
+#include <algorithm>
 
 
 
 namespace graph {
 
 	graph::graph()
-		:points(), edges(), maxX(0), minX(0), maxY(0), minY(0) {}
+		:pointX(), pointY(), pointZ(),
+		origin(), twin(), prev(), next(), marks(), epoch(1),
+		faces(), facesAreValid(false),
+		maxX(0), minX(0), maxY(0), minY(0), locateStepNum(0), exactPredicateNum(0), newID(), pairOffset(), pairBucket() {}
 
 	graph::~graph() {
-		size_t pointNum = getPointNum();
-		for (size_t i = 0; i < pointNum; i++) {
-			delete getPoint(i);
-		}
-		size_t edgeNum = getEdgeNum();
-		for (size_t i = 0; i <edgeNum; i++) {
-			delete getEdge(i);
-		}
 		init();
 	}
 
 	void graph::init() {
-		points.resize(0);
-		points.shrink_to_fit();
-		edges.resize(0);
-		edges.shrink_to_fit();
+		//keeps capacity to reuse memory for the next model
+		pointX.clear();
+		pointY.clear();
+		pointZ.clear();
+		origin.clear();
+		twin.clear();
+		prev.clear();
+		next.clear();
+		marks.clear();
+		faces.clear();
+		facesAreValid = false;
+		locateStepNum = 0;
+		exactPredicateNum = 0;
 	}
 
 	double graph::getMaxX() {
@@ -55,247 +62,389 @@ namespace graph {
 
 	//*point functions*
 
-	size_t graph::getPointNum() {
-		return points.size();
-	}
-
-	void graph::addPoint(double px, double py, double pz) {
-		size_t size = points.size();
-		points.resize(size + 1);
-		points[size] = new point(px, py, pz, size);
-	}
-
-	void graph::addPointObject(point* p) {
-		size_t size = points.size();
-		points.resize(size + 1);
-		p->setID(size);
-		points[size] = p;
+	pointIndex graph::addPoint(double px, double py, double pz) {
+		pointIndex size = (pointIndex)pointX.size();
+		pointX.push_back(px);
+		pointY.push_back(py);
+		pointZ.push_back(pz);
+		return size;
 	}
 
-	point* graph::getPoint(size_t index) {
-		return points[index];
+	pointIndex graph::addPoint(const point& p) {
+		return addPoint(p.getX(), p.getY(), p.getZ());
 	}
 
 	void graph::addPoints(double* point_coords, size_t pointNum) {
 		if (pointNum < 3) throw graphException("graph", "addPoints : 'pointNum' should be more equal than 3");
 		//init points vector
-		points.resize(pointNum);
+		pointX.resize(pointNum);
+		pointY.resize(pointNum);
+		pointZ.resize(pointNum);
 
 		double x, y;
-		maxX = DBL_MIN, maxY = DBL_MIN, minX = DBL_MAX, minY = DBL_MAX;
+		maxX = -DBL_MAX, maxY = -DBL_MAX, minX = DBL_MAX, minY = DBL_MAX;
 
 		//add points
 		for (size_t i = 0; i < pointNum; i++) {
 			x = point_coords[i * 2];
 			y = point_coords[i * 2 + 1];
-			maxX = max(x, maxX);
-			maxY = max(y, maxY);
-			minX = min(x, minX);
-			minY = min(y, minY);
-			points[i] = new point(x, y, 0, i);
+			maxX = (std::max)(x, maxX);
+			maxY = (std::max)(y, maxY);
+			minX = (std::min)(x, minX);
+			minY = (std::min)(y, minY);
+			pointX[i] = x;
+			pointY[i] = y;
+			pointZ[i] = 0;
 		}
 	}
 
-	void graph::resetPointID() {
-		for (size_t i = 0; i < getPointNum(); i++) {
-			points[i]->setID(i);
+	void graph::deletePoint(size_t index) {
+		pointX.erase(pointX.begin() + index);
+		pointY.erase(pointY.begin() + index);
+		pointZ.erase(pointZ.begin() + index);
+
+		//shift point indices of edges
+		for (size_t i = 0; i < origin.size(); i++) {
+			if (origin[i] > index) origin[i] -= 1;
 		}
 	}
 
-	void graph::deletePoint(size_t index) {
-		delete getPoint(index);
-		points.erase(points.begin() + index);
+	void graph::deleteLastPoint(size_t deleteNum) {
+		size_t size = pointX.size();
+		pointX.resize(size - deleteNum);
+		pointY.resize(size - deleteNum);
+		pointZ.resize(size - deleteNum);
 	}
 
-	void graph::deleteLastPoint(size_t deleteNum) {
-		size_t size = points.size();
-		for (size_t i = 0; i < deleteNum; i++) {
-			delete points[size - i - 1];
+	void graph::deletePoints(const std::vector<bool>& deleteFlag, std::vector<pointIndex>* remap) {
+		size_t size = pointX.size();
+		newID.resize(size);
+		pointIndex count = 0;
+		for (size_t i = 0; i < size; i++) {
+			if (deleteFlag[i]) {
+				newID[i] = NULL_POINT;
+				continue;
+			}
+			newID[i] = count;
+			pointX[count] = pointX[i];
+			pointY[count] = pointY[i];
+			pointZ[count] = pointZ[i];
+			count++;
 		}
-		points.erase(points.begin() + size - deleteNum, points.begin() + size);
+		pointX.resize(count);
+		pointY.resize(count);
+		pointZ.resize(count);
+
+		//shift point indices of edges
+		for (size_t i = 0; i < origin.size(); i++) {
+			origin[i] = newID[origin[i]];
+		}
+
+		//copied (not swapped) so both buffers keep their capacity
+		if (remap != nullptr) remap->assign(newID.begin(), newID.end());
 	}
 
 	//*edge functions*
 
-	size_t graph::getEdgeNum() {
-		return edges.size();
+	edgeIndex graph::newEdge(pointIndex p1, edgeIndex pairE, edgeIndex prevE, edgeIndex nextE) {
+		edgeIndex size = (edgeIndex)origin.size();
+		origin.push_back(p1);
+		twin.push_back(pairE);
+		prev.push_back(prevE);
+		next.push_back(nextE);
+		marks.push_back(0);
+		facesAreValid = false;
+		return size;
 	}
 
-	void graph::addEdge(size_t tailPointID, size_t headPointID) {
-		size_t size = edges.size();
-		edges.resize(size + 1);
-		edges[size] = new edge(points[tailPointID], points[headPointID]);
+	edgeIndex graph::addEdge(size_t tailPointID, size_t headPointID) {
+		//an edge without faces is stored as a pair of half edges
+		edgeIndex e = newEdge((pointIndex)tailPointID);
+		edgeIndex pair = newEdge((pointIndex)headPointID);
+		makePair(e, pair);
+		return e;
 	}
 
 	void graph::addFace(size_t p1ID, size_t p2ID, size_t p3ID) {
-		size_t size = edges.size();
-		edges.resize(size + 3);
-
-		point* p1 = points[p1ID];
-		point* p2 = points[p2ID];
-		point* p3 = points[p3ID];
-		edge* e1 = new edge(p1, p2);
-		edge* e2 = new edge(p2, p3);
-		edge* e3 = new edge(p3, p1);
-		edges[size] = e1;
-		edges[size+1] = e2;
-		edges[size+2] = e3;
-		e1->setPrevEdge(e3);
-		e2->setPrevEdge(e1);
-		e3->setPrevEdge(e2);
-	}
-	
-	edge* graph::getEdge(size_t index) {
-		return edges[index];
+		edgeIndex e1 = newEdge((pointIndex)p1ID);
+		edgeIndex e2 = newEdge((pointIndex)p2ID);
+		edgeIndex e3 = newEdge((pointIndex)p3ID);
+		setPrevEdge(e1, e3);
+		setPrevEdge(e2, e1);
+		setPrevEdge(e3, e2);
 	}
 
 	void graph::deleteEdge(size_t index) {
-		edge* e = getEdge(index);
-		delete e;
-		edges.erase(edges.begin() + index);
+		edgeIndex pair = twin[index];
+		if (pair != NULL_EDGE) twin[pair] = NULL_EDGE;
+
+		origin.erase(origin.begin() + index);
+		twin.erase(twin.begin() + index);
+		prev.erase(prev.begin() + index);
+		next.erase(next.begin() + index);
+		marks.erase(marks.begin() + index);
+		facesAreValid = false;
+
+		//shift edge indices
+		edgeIndex id = (edgeIndex)index;
+		edgeIndex* links[3];
+		for (size_t i = 0; i < origin.size(); i++) {
+			links[0] = &twin[i];
+			links[1] = &prev[i];
+			links[2] = &next[i];
+			for (int j = 0; j < 3; j++) {
+				if (*links[j] == NULL_EDGE) continue;
+				if (*links[j] == id) *links[j] = NULL_EDGE;
+				else if (*links[j] > id) *links[j] -= 1;
+			}
+		}
 	}
 
-	void graph::setPairEdge(size_t edgeID, size_t pairEdgeID) {
-		edges[edgeID]->setPairEdge(edges[pairEdgeID]);
+	void graph::deleteFlaggedEdges(std::vector<edgeIndex>* remap) {
+		size_t size = origin.size();
+		newID.resize(size);
+		edgeIndex count = 0;
+		for (size_t i = 0; i < size; i++) {
+			if (marks[i] == epoch) {
+				newID[i] = NULL_EDGE;
+			}
+			else {
+				newID[i] = count;
+				count++;
+			}
+		}
+
+		//move edges and shift edge indices (links to deleted edges become NULL_EDGE)
+		edgeIndex id;
+		for (size_t i = 0; i < size; i++) {
+			id = newID[i];
+			if (id == NULL_EDGE) continue;
+			origin[id] = origin[i];
+			twin[id] = twin[i] == NULL_EDGE ? NULL_EDGE : newID[twin[i]];
+			prev[id] = prev[i] == NULL_EDGE ? NULL_EDGE : newID[prev[i]];
+			next[id] = next[i] == NULL_EDGE ? NULL_EDGE : newID[next[i]];
+			marks[id] = 0;
+		}
+		origin.resize(count);
+		twin.resize(count);
+		prev.resize(count);
+		next.resize(count);
+		marks.resize(count);
+		facesAreValid = false;
+
+		//copied (not swapped) so both buffers keep their capacity
+		if (remap != nullptr) remap->assign(newID.begin(), newID.end());
 	}
 
-	void graph::setPrevEdge(size_t edgeID, size_t prevEdgeID) {
-		edges[edgeID]->setPrevEdge(edges[prevEdgeID]);
+	void graph::clearEdges() {
+		origin.clear();
+		twin.clear();
+		prev.clear();
+		next.clear();
+		marks.clear();
+		facesAreValid = false;
 	}
 
-	void graph::resetFlag() {
-		for (size_t i = 0; i < edges.size(); i++) {
-			edges[i]->setFlag(false);
-		}
+	void graph::getPointID(edgeIndex e, size_t* p1_id, size_t* p2_id) {
+		*p1_id = getP1(e);
+		*p2_id = getP2(e);
+	}
+
+	void graph::setPairEdge(edgeIndex edgeID, edgeIndex pairEdgeID) {
+		twin[edgeID] = pairEdgeID;
 	}
 
-	void graph::makePair(size_t edgeID1, size_t edgeID2) {
-		size_t size = edges.size();
+	void graph::setPrevEdge(edgeIndex edgeID, edgeIndex prevEdgeID) {
+		prev[edgeID] = prevEdgeID;
+		next[prevEdgeID] = edgeID;
+		facesAreValid = false;
+	}
+
+	void graph::makePair(edgeIndex edgeID1, edgeIndex edgeID2) {
+		size_t size = origin.size();
 		if (size <= edgeID1 || size <= edgeID2) {
 			throw graphException("graph","setPair : edgeID is larger than last index");
 		}
-		makeEdgePair(edges[edgeID1],edges[edgeID2]);
+		twin[edgeID1] = edgeID2;
+		twin[edgeID2] = edgeID1;
+	}
+
+	void graph::makePairs() {
+		//buckets edges by their smaller point id (counting sort keeps edges in index order)
+		size_t size = origin.size();
+		size_t pointNum = pointX.size();
+		pairOffset.assign(pointNum + 1, 0);
+		for (size_t i = 0; i < size; i++) {
+			pairOffset[(std::min)(getP1((edgeIndex)i), getP2((edgeIndex)i)) + 1]++;
+		}
+		for (size_t i = 0; i < pointNum; i++) {
+			pairOffset[i + 1] += pairOffset[i];
+		}
+		pairBucket.resize(size);
+		pointIndex p;
+		for (size_t i = 0; i < size; i++) {
+			p = (std::min)(getP1((edgeIndex)i), getP2((edgeIndex)i));
+			pairBucket[pairOffset[p]] = (edgeIndex)i;
+			pairOffset[p]++;
+		}
+
+		//pairs edges with the same larger point id in each bucket (pairOffset[p] is the end of bucket p now)
+		size_t start = 0;
+		edgeIndex e, f;
+		pointIndex q;
+		for (size_t p = 0; p < pointNum; p++) {
+			for (size_t i = start; i < pairOffset[p]; i++) {
+				e = pairBucket[i];
+				if (e == NULL_EDGE) continue;
+				q = (std::max)(getP1(e), getP2(e));
+				for (size_t j = i + 1; j < pairOffset[p]; j++) {
+					f = pairBucket[j];
+					if (f == NULL_EDGE || (std::max)(getP1(f), getP2(f)) != q) continue;
+					makePair(e, f);
+					pairBucket[j] = NULL_EDGE;
+					break;
+				}
+			}
+			start = pairOffset[p];
+		}
+	}
+
+	void graph::resetFlag() {
+		epoch++;
+		if (epoch == 0) {//wrapped around
+			for (size_t i = 0; i < marks.size(); i++) {
+				marks[i] = 0;
+			}
+			epoch = 1;
+		}
+	}
+
+	double graph::len_sq(edgeIndex e) {
+		return squaredDistance(getPoint(getP1(e)), getPoint(getP2(e)));
+	}
+
+	double graph::len(edgeIndex e) {
+		return distance(getPoint(getP1(e)), getPoint(getP2(e)));
+	}
+
+	point graph::getMidPoint(edgeIndex e) {
+		return mid(getPoint(getP1(e)), getPoint(getP2(e)));
+	}
+
+	point graph::getCenterPoint(edgeIndex e) {
+		return center(getPoint(getP1(e)), getPoint(getP2(e)), getPoint(getP3(e)));
+	}
+
+	//*face functions*
+
+	void graph::updateFaces() {
+		if (facesAreValid) return;
+		faces.clear();
+		size_t size = origin.size();
+		for (size_t i = 0; i < size; i++) {
+			if (prev[i] == NULL_EDGE) continue;//edge without faces
+			if (i < prev[i] && i < next[i]) faces.push_back((edgeIndex)i);
+		}
+		facesAreValid = true;
+	}
+
+	size_t graph::getFaceNum() {
+		updateFaces();
+		return faces.size();
+	}
+
+	edgeIndex graph::getFaceEdge(size_t index) {
+		updateFaces();
+		return faces[index];
 	}
 
 	//splits the face has edge e and inserts point p in the face.
-	void graph::insertPoint(point* p, edge* e, std::stack<edge*>* edgeStack) {
-
-		point* p1 = e->getP1();
-		point* p2 = e->getP2();
-		point* p3 = e->getP3();
-
-		edge* prev = e->getPrevEdge();
-		edge* next = prev->getPrevEdge();
-
-		edge* p_p1, * p2_p, * p_p2;
-		edge* p3_p, * p_p3, * p1_p;
-
-		p_p1 = new edge(p, p1);
-		p2_p = new edge(p2, p);
-		p_p1->setPrevEdge(p2_p);
-		p2_p->setPrevEdge(e);
-		e->setPrevEdge(p_p1);
-
-		p_p2 = new edge(p, p2);
-		p3_p = new edge(p3, p);
-		p_p2->setPrevEdge(p3_p);
-		p3_p->setPrevEdge(next);
-		next->setPrevEdge(p_p2);
-
-		p_p3 = new edge(p, p3);
-		p1_p = new edge(p1, p);
-		p_p3->setPrevEdge(p1_p);
-		p1_p->setPrevEdge(prev);
-		prev->setPrevEdge(p_p3);
-
-		makeEdgePair(p_p1, p1_p);
-		makeEdgePair(p_p2, p2_p);
-		makeEdgePair(p_p3, p3_p);
-
-		size_t size = edges.size();
-		edges.resize(size + 6);
-		edges[size] = p_p1;
-		edges[size + 1] = p2_p;
-		edges[size + 2] = p_p2;
-		edges[size + 3] = p3_p;
-		edges[size + 4] = p_p3;
-		edges[size + 5] = p1_p;
-		
+	void graph::insertPoint(pointIndex p, edgeIndex e, edgeIndexStack* edgeStack) {
+
+		pointIndex p1 = getP1(e);
+		pointIndex p2 = getP2(e);
+		pointIndex p3 = getP3(e);
+
+		edgeIndex prevE = getPrevEdge(e);
+		edgeIndex nextE = getPrevEdge(prevE);
+
+		edgeIndex p_p1 = newEdge(p);
+		edgeIndex p2_p = newEdge(p2);
+		edgeIndex p_p2 = newEdge(p);
+		edgeIndex p3_p = newEdge(p3);
+		edgeIndex p_p3 = newEdge(p);
+		edgeIndex p1_p = newEdge(p1);
+
+		setPrevEdge(p_p1, p2_p);
+		setPrevEdge(p2_p, e);
+		setPrevEdge(e, p_p1);
+
+		setPrevEdge(p_p2, p3_p);
+		setPrevEdge(p3_p, nextE);
+		setPrevEdge(nextE, p_p2);
+
+		setPrevEdge(p_p3, p1_p);
+		setPrevEdge(p1_p, prevE);
+		setPrevEdge(prevE, p_p3);
+
+		makePair(p_p1, p1_p);
+		makePair(p_p2, p2_p);
+		makePair(p_p3, p3_p);
+
 		if (edgeStack == nullptr) return;
 		edgeStack->push(e);
-		edgeStack->push(prev);
-		edgeStack->push(next);
+		edgeStack->push(prevE);
+		edgeStack->push(nextE);
 	}
 
 	//splits edge e and inserts point p
-	void graph::insertPoint2(point* p, edge* e, std::stack<edge*>* edgeStack, edge* newpair1, edge* newpair2) {
-		point* p1 = e->getP1();
-		point* p2 = e->getP2();
-		point* p3 = e->getP3();
+	void graph::insertPoint2(pointIndex p, edgeIndex e, edgeIndexStack* edgeStack, edgeIndex newpair1, edgeIndex newpair2) {
+		pointIndex p3 = getP3(e);
 
-		edge* prev = e->getPrevEdge();
-		edge* next = prev->getPrevEdge();
+		edgeIndex prevE = getPrevEdge(e);
+		edgeIndex nextE = getPrevEdge(prevE);
 
-		edge* p_p3, * p_p2, * p3_p;
+		//e=(p1,p) after linking p_p3 as the next edge
+		edgeIndex p_p3 = newEdge(p);
+		setPrevEdge(p_p3, e);
+		setPrevEdge(prevE, p_p3);
 
-		e->setPoint(p1, p);
-		p_p3 = new edge(p, p3);
-		p_p3->setPrevEdge(e);
-		prev->setPrevEdge(p_p3);
+		edgeIndex p_p2 = newEdge(p);
+		edgeIndex p3_p = newEdge(p3);
+		setPrevEdge(p_p2, p3_p);
+		setPrevEdge(p3_p, nextE);
+		setPrevEdge(nextE, p_p2);
 
-		p_p2 = new edge(p, p2);
-		p3_p = new edge(p3, p);
-		p_p2->setPrevEdge(p3_p);
-		p3_p->setPrevEdge(next);
-		next->setPrevEdge(p_p2);
-
-		makeEdgePair(p_p3, p3_p);
-
-		size_t size = edges.size();
-		edges.resize(size + 3);
-		edges[size] = p_p3;
-		edges[size + 1] = p_p2;
-		edges[size + 2] = p3_p;
+		makePair(p_p3, p3_p);
 
 		if (edgeStack != nullptr) {
-			edgeStack->push(prev);
-			edgeStack->push(next);
+			edgeStack->push(prevE);
+			edgeStack->push(nextE);
 		}
 
-		if (newpair1 == nullptr) {//splits edge "pair" by point p
-			edge* pair = e->getPairEdge();
+		if (newpair1 == NULL_EDGE) {//splits edge "pair" by point p
+			edgeIndex pair = getPairEdge(e);
 
-			if (pair != nullptr) {
-				insertPoint2(p, pair, edgeStack, edges[size + 1],e);
+			if (pair != NULL_EDGE) {
+				insertPoint2(p, pair, edgeStack, p_p2, e);
 			}
 		}
 		else {//sets pair edge to splited edge
-			makeEdgePair(e, newpair1);
-			makeEdgePair(p_p2, newpair2);
+			makePair(e, newpair1);
+			makePair(p_p2, newpair2);
 		}
 	}
 
-	//finds a face include point p and inserts the point
-	bool graph::findFaceIncludePoint(point* p, edge* e, std::stack<edge*>* edgeStack) {
-
-		//printf("findFaceIncludePoint\n");
-		bool inserted = false;
-
-		//check
-		point* p1 = e->getP1();
-		point* p2 = e->getP2();
-		point* p3 = e->getP3();
-
-		if (p1 == nullptr) throw(graphException("graph","findFaceIncludePoint : p1 is nullptr"));
-		if (p2 == nullptr) throw(graphException("graph","findFaceIncludePoint : p2 is nullptr"));
+	bool graph::insertPointIfInFace(pointIndex p, edgeIndex e, edgeIndex* nextE, edgeIndexStack* edgeStack) {
+		point target = getPoint(p);
+		point p1 = getPoint(getP1(e));
+		point p2 = getPoint(getP2(e));
+		point p3 = getPoint(getP3(e));
 
 		//CP>0: inside, CP=0: online, CP<0: outside
-		double CPp1p2 = crossprod2D(p, p1, p2);
-		double CPp2p3 = crossprod2D(p, p2, p3);
-		double CPp3p1 = crossprod2D(p, p3, p1);
-
-		//fix rounding error
-		if (abs(CPp1p2) < 1e-15) { CPp1p2 = 0; }
+		double CPp1p2 = orient2D(target, p1, p2, &exactPredicateNum);
+		double CPp2p3 = orient2D(target, p2, p3, &exactPredicateNum);
+		double CPp3p1 = orient2D(target, p3, p1, &exactPredicateNum);
 
 		if (CPp1p2 >= 0 && CPp2p3 >= 0 && CPp3p1 >= 0) {
 			//found the face!
@@ -307,44 +456,90 @@ namespace graph {
 				insertPoint2(p, e, edgeStack);
 			}
 			else if (CPp2p3 == 0) {
-				insertPoint2(p, e->getPrevEdge()->getPrevEdge(), edgeStack);
+				insertPoint2(p, getPrevEdge(getPrevEdge(e)), edgeStack);
 			}
 			else {
-				insertPoint2(p, e->getPrevEdge(), edgeStack);
+				insertPoint2(p, getPrevEdge(e), edgeStack);
 			}
 			return true;
 		}
 
-		//search other faces
-		edge* next = e;
+		//the next face is on the other side of nextE
+		*nextE = e;
 		if (CPp2p3 < 0) {
-			next = e->getPrevEdge()->getPrevEdge();
+			*nextE = getPrevEdge(getPrevEdge(e));
 		}
 		else if (CPp3p1 < 0) {
-			next = e->getPrevEdge();
+			*nextE = getPrevEdge(e);
 		}
-		edge* nextPair = next->getPairEdge();
-		if (nextPair == nullptr) return false;
+		return false;
+	}
 
-		inserted = inserted || findFaceIncludePoint(p, nextPair, edgeStack);
-		return inserted;
+	//finds a face include point p and inserts the point
+	bool graph::findFaceIncludePoint(pointIndex p, edgeIndex e, edgeIndexStack* edgeStack) {
+
+		//check
+		if (e == NULL_EDGE) throw(graphException("graph","findFaceIncludePoint : e is NULL_EDGE"));
+
+		//walks to the face
+		edgeIndex nextE;
+		size_t maxStep = origin.size();
+		for (size_t step = 0; step < maxStep; step++) {
+			locateStepNum++;
+			if (insertPointIfInFace(p, e, &nextE, edgeStack)) return true;
+
+			e = getPairEdge(nextE);
+			if (e == NULL_EDGE) return false;//p is out of the graph
+		}
+
+		//the walk is too long (e.g. it's looping on a degenerate face). searches all faces.
+		size_t size = origin.size();
+		for (size_t i = 0; i < size; i++) {
+			if (prev[i] == NULL_EDGE) continue;//edge without faces
+			locateStepNum++;
+			if (insertPointIfInFace(p, (edgeIndex)i, &nextE, edgeStack)) return true;
+		}
+		return false;
 	}
 
-	void graph::flipEdge(edge* e, edge* pair, point* p3, point* p4, std::stack<edge*>* edgeStack) {
-		edge* prev = e->getPrevEdge();
-		edge* next = prev->getPrevEdge();
-		edge* pairPrev = pair->getPrevEdge();
-		edge* pairNext = pairPrev->getPrevEdge();
+	size_t graph::getLocateStepNum() {
+		return locateStepNum;
+	}
 
-		e->setPoint(p3, p4);
-		e->setPrevEdge(next);
-		next->setPrevEdge(pairPrev);
-		pairPrev->setPrevEdge(e);
+	void graph::resetLocateStepNum() {
+		locateStepNum = 0;
+	}
 
-		pair->setPoint(p4, p3);
-		pair->setPrevEdge(pairNext);
-		pairNext->setPrevEdge(prev);
-		prev->setPrevEdge(pair);
+	size_t graph::getExactPredicateNum() {
+		return exactPredicateNum;
+	}
+
+	size_t* graph::getExactPredicateCounter() {
+		return &exactPredicateNum;
+	}
+
+	void graph::resetExactPredicateNum() {
+		exactPredicateNum = 0;
+	}
+
+	void graph::flipEdge(edgeIndex e, edgeIndex pair, edgeIndexStack* edgeStack) {
+		pointIndex p3 = getP3(e);
+		pointIndex p4 = getP3(pair);
+
+		edgeIndex prevE = getPrevEdge(e);
+		edgeIndex nextE = getPrevEdge(prevE);
+		edgeIndex pairPrev = getPrevEdge(pair);
+		edgeIndex pairNext = getPrevEdge(pairPrev);
+
+		origin[e] = p3;
+		setPrevEdge(e, nextE);
+		setPrevEdge(nextE, pairPrev);
+		setPrevEdge(pairPrev, e);
+
+		origin[pair] = p4;
+		setPrevEdge(pair, pairNext);
+		setPrevEdge(pairNext, prevE);
+		setPrevEdge(prevE, pair);
 
 		if (edgeStack == nullptr) return;
 		edgeStack->push(pairPrev);
@@ -355,35 +550,47 @@ namespace graph {
 		size_t size = getPointNum();
 		if (size < 3) return;
 
-		point* p;
 		for (size_t i = 0; i < size; i++) {
-			p = points[i];
-			point_coords[i * 2] = p->getX();
-			point_coords[i * 2 + 1] = p->getY();
+			point_coords[i * 2] = pointX[i];
+			point_coords[i * 2 + 1] = pointY[i];
 		}
 
 		size = getEdgeNum();
-		double* coords = new double[4];
+		pointIndex p1, p2;
 		for (size_t i = 0; i < size; i++) {
-			edges[i]->getCoord(coords);
-			memmove(&edge_coords[i * 4], coords, sizeof(double) * 4);
+			p1 = getP1((edgeIndex)i);
+			p2 = getP2((edgeIndex)i);
+			edge_coords[i * 4] = pointX[p1];
+			edge_coords[i * 4 + 1] = pointY[p1];
+			edge_coords[i * 4 + 2] = pointX[p2];
+			edge_coords[i * 4 + 3] = pointY[p2];
 		}
-		delete[] coords;
+	}
 
+	void graph::getPointsEdges(double* point_coords, pointIndex* edge_points) {
+		size_t size = getPointNum();
+		for (size_t i = 0; i < size; i++) {
+			point_coords[i * 2] = pointX[i];
+			point_coords[i * 2 + 1] = pointY[i];
+		}
+
+		size = getEdgeNum();
+		for (size_t i = 0; i < size; i++) {
+			edge_points[i * 2] = getP1((edgeIndex)i);
+			edge_points[i * 2 + 1] = getP2((edgeIndex)i);
+		}
 	}
 
 	void graph::getPoints(double* point_coords) {
 		size_t size = getPointNum();
-		point* p;
 
 		size_t i3;
 		for (size_t i = 0; i < size; i++) {
-			p = points[i];
 			i3 = i * 3;
-			point_coords[i3] = p->getX();
-			point_coords[i3 + 1] = p->getY();
-			point_coords[i3 + 2] = p->getZ();
+			point_coords[i3] = pointX[i];
+			point_coords[i3 + 1] = pointY[i];
+			point_coords[i3 + 2] = pointZ[i];
 		}
 	}
 
-}
\ No newline at end of file
+}
@@ -3,7 +3,12 @@
  * --------------------
  * This file contains the declaration of directed graph.
  *
+ * Points and half edges are stored as arrays (structure of arrays).
+ * point i  : (pointX[i], pointY[i], pointZ[i])
+ * edge i   : origin[i]->origin[next[i]], pair edge is twin[i]
+ *
  * See graph.cpp for implementation of each member.
+ * Accessors are inline at the end of this file.
  *
  * @author Matyalatte
  * @version 2021/09/14
@@ -15,20 +20,54 @@
 #include "exception.hpp"
 #include "edge.hpp"
 #include "utils.hpp"
-//#include <vector>
+#include <vector>
 #include <stack>
- //#include "point.h"
 
 namespace graph {
 
+	//a stack of edges to check (vector based, so it keeps its capacity)
+	typedef std::stack<edgeIndex, std::vector<edgeIndex>> edgeIndexStack;
+
 	class graph {
 
 	private:
 		//*parameters*
-		std::vector<point*> points; // points
-		std::vector<edge*> edges; // edges
+
+		//point coordinates
+		std::vector<double> pointX;
+		std::vector<double> pointY;
+		std::vector<double> pointZ;
+
+		//half edges
+		std::vector<pointIndex> origin;// p1 of each edge
+		std::vector<edgeIndex> twin;// pair edge
+		std::vector<edgeIndex> prev;// previous edge in the face
+		std::vector<edgeIndex> next;// next edge in the face
+		std::vector<uint32_t> marks;// flags for traversal (the flag is true if marks[i] == epoch)
+		uint32_t epoch;// resetFlag() starts a new epoch instead of clearing marks
+
+		//faces (cached, rebuilt after edges are changed)
+		std::vector<edgeIndex> faces;// the edge with the smallest index in each face
+		bool facesAreValid;
+
 		double maxX, minX, maxY, minY; // graph area
 
+		size_t locateStepNum;// the number of faces visited by findFaceIncludePoint
+		size_t exactPredicateNum;// the number of predicate calls that needed exact arithmetic (see predicates.hpp)
+
+		std::vector<uint32_t> newID;// new indices of points or edges (work buffer of deletePoints and deleteFlaggedEdges)
+		std::vector<size_t> pairOffset;// edges are bucketed by their smaller point id (work buffers of makePairs)
+		std::vector<edgeIndex> pairBucket;
+
+		//rebuilds faces if edges were changed
+		void updateFaces();
+
+		//appends a half edge to the arrays
+		edgeIndex newEdge(pointIndex p1, edgeIndex pairE = NULL_EDGE, edgeIndex prevE = NULL_EDGE, edgeIndex nextE = NULL_EDGE);
+
+		//inserts point p if the face has edge e includes p.
+		//if not, nextE is the edge of the face p is on the other side of.
+		bool insertPointIfInFace(pointIndex p, edgeIndex e, edgeIndex* nextE, edgeIndexStack* edgeStack);
 
 	public:
 		graph();
@@ -44,75 +83,219 @@ namespace graph {
 
 		//*point functions*-----
 
-		//get points.size()
+		//get the number of points
 		size_t getPointNum();
 
-		//add a point (px,py,pz) to graph
-		void addPoint(double px, double py, double pz = 0);
+		//add a point (px,py,pz) to graph and returns its index
+		pointIndex addPoint(double px, double py, double pz = 0);
 
-		//add point p to graph
-		void addPointObject(point* p);
+		//add point p to graph and returns its index
+		pointIndex addPoint(const point& p);
 
 		//add points to graph
 		void addPoints(double* point_coords, size_t pointNum);
 
-		//get points[index]
-		point* getPoint(size_t index);
+		//get a copy of points[index]
+		point getPoint(pointIndex index);
 
-		//points[i]->setID(i) (i=0,1,2,...)
-		void resetPointID();
-		
-		//delete edges[index]
+		//get coordinates of points[index]
+		double getX(pointIndex index);
+		double getY(pointIndex index);
+		double getZ(pointIndex index);
+		void setZ(pointIndex index, double pz);
+
+		//delete points[index]
 		void deletePoint(size_t index);
 
 		//delete last 'deleteNum' points
 		void deleteLastPoint(size_t deleteNum);
 
+		//delete points[i] if deleteFlag[i] is true (in a single pass)
+		//remap[old index] = new index (NULL_POINT for deleted points) if remap is not nullptr
+		void deletePoints(const std::vector<bool>& deleteFlag, std::vector<pointIndex>* remap = nullptr);
+
 		//*edge functions*-----
 
-		//get edges.size()
+		//get the number of half edges
 		size_t getEdgeNum();
 
-		//add an edge (points[tailID]->points[headID])
-		void addEdge(size_t tailPointID, size_t headPointID);
-
-		//get edges[index]
-		edge* getEdge(size_t index);
+		//add an edge (points[tailID]->points[headID]) and its pair edge
+		edgeIndex addEdge(size_t tailPointID, size_t headPointID);
 
 		//delete edges[index]
 		void deleteEdge(size_t index);
 
+		//delete edges their flags are true (in a single pass)
+		//remap[old index] = new index (NULL_EDGE for deleted edges) if remap is not nullptr
+		void deleteFlaggedEdges(std::vector<edgeIndex>* remap = nullptr);
+
+		//delete all edges
+		void clearEdges();
+
 		//add 3 edges (p1->2, p2->p3, p3->1)
 		void addFace(size_t p1ID, size_t p2ID, size_t p3ID);
 
-		//edges[edgeID]->setPrevEdge(edges[prevEdgeID])
-		void setPrevEdge(size_t edgeID, size_t prevEdgeID);
+		//get points of edge e (p1->p2, p3 is prevE.p1)
+		pointIndex getP1(edgeIndex e);
+		pointIndex getP2(edgeIndex e);
+		pointIndex getP3(edgeIndex e);
+		void getPointID(edgeIndex e, size_t* p1_id, size_t* p2_id);
 
-		//edges[edgeID]->setPairEdge(edges[pairEdgeID])
-		void setPairEdge(size_t edgeID, size_t pairEdgeID);
-		
-		//resets flags of edges
-		void resetFlag();
+		//get linked edges
+		edgeIndex getPairEdge(edgeIndex e);
+		edgeIndex getPrevEdge(edgeIndex e);
+		edgeIndex getNextEdge(edgeIndex e);
+
+		//edges[edgeID].prevE = edges[prevEdgeID] (and edges[prevEdgeID].nextE = edges[edgeID])
+		void setPrevEdge(edgeIndex edgeID, edgeIndex prevEdgeID);
+
+		//edges[edgeID].pairE = edges[pairEdgeID] (NULL_EDGE disconnects the pair)
+		void setPairEdge(edgeIndex edgeID, edgeIndex pairEdgeID = NULL_EDGE);
 
 		//makes a pair of edges.
-		void makePair(size_t edgeID1, size_t edgeID2);
+		void makePair(edgeIndex edgeID1, edgeIndex edgeID2);
+
+		//makes pairs of all edges with the same points (p1->p2 and p2->p1) in linear time
+		void makePairs();
+
+		//flags of edges
+		void setFlag(edgeIndex e, bool f);
+		bool getFlag(edgeIndex e);
+
+		//resets flags of edges (O(1))
+		void resetFlag();
+
+		//gets the length of the edge
+		double len(edgeIndex e);
+
+		//gets the squared length of the edge
+		double len_sq(edgeIndex e);
+
+		//gets the mid point of the edge
+		point getMidPoint(edgeIndex e);
+
+		//gets the center point of the face with the edge
+		point getCenterPoint(edgeIndex e);
+
+		//*face functions*-----
+
+		//get the number of faces
+		size_t getFaceNum();
+
+		//get an edge of faces[index] (faces are sorted by the smallest edge index in them)
+		edgeIndex getFaceEdge(size_t index);
 
 		//splits the face has edge e and inserts point p in the face.
-		void insertPoint(point* p, edge* e, std::stack<edge*>* edgeStack = nullptr);
+		void insertPoint(pointIndex p, edgeIndex e, edgeIndexStack* edgeStack = nullptr);
 
 		//splits edge e and inserts point p
-		void insertPoint2(point* p, edge* e, std::stack<edge*>* edgeStack = nullptr, edge* newpair1 = nullptr, edge* newpair2 = nullptr);
+		void insertPoint2(pointIndex p, edgeIndex e, edgeIndexStack* edgeStack = nullptr, edgeIndex newpair1 = NULL_EDGE, edgeIndex newpair2 = NULL_EDGE);
+
+		//finds a face includes point p (walks from edge e) and inserts the point
+		//if the walk doesn't reach the face in getEdgeNum() steps, searches all faces
+		bool findFaceIncludePoint(pointIndex p, edgeIndex e, edgeIndexStack* edgeStack);
 
-		//finds a face includes point p
-		bool findFaceIncludePoint(point* p, edge* e, std::stack<edge*>* edgeStack);
+		//the number of faces visited by findFaceIncludePoint since the last reset
+		size_t getLocateStepNum();
+		void resetLocateStepNum();
 
-		//flip edge e (e=(p1,p2), pair=(p2,p1), e.prevE=(p3,p1), pair.prevE=(p4,p2))
-		void flipEdge(edge* e, edge* pair, point* p3, point* p4, std::stack<edge*>* edgeStack = nullptr);
+		//the number of predicate calls that needed exact arithmetic since the last reset
+		//graph handlers count them with the pointer (exactNum of orient2D, inCircle, etc.)
+		size_t getExactPredicateNum();
+		size_t* getExactPredicateCounter();
+		void resetExactPredicateNum();
+
+		//flip edge e (e=(p1,p2), pair=(p2,p1), e.prevE=(p3,p1), pair.prevE=(p4,p2)) to e=(p3,p4), pair=(p4,p3)
+		void flipEdge(edgeIndex e, edgeIndex pair, edgeIndexStack* edgeStack = nullptr);
 
 		//get graph data
 		void getPointsEdgesAsCoords(double* point_coords, double* edge_coords);
-		
+
+		//get 2D coordinates of points and point indices of edges ({e1_p1, e1_p2, e2_p1, ...})
+		void getPointsEdges(double* point_coords, pointIndex* edge_points);
+
 		//get points coordinates
 		void getPoints(double* point_coords);
+
+		//get pointers to coordinate arrays (valid until points are added or deleted)
+		const double* getPointerToX();
+		const double* getPointerToY();
+		const double* getPointerToZ();
 	};
-}
\ No newline at end of file
+
+	//*inline accessors*
+	//(they are called in inner loops of every stage)
+
+	inline size_t graph::getPointNum() {
+		return pointX.size();
+	}
+
+	inline point graph::getPoint(pointIndex index) {
+		return point(pointX[index], pointY[index], pointZ[index]);
+	}
+
+	inline double graph::getX(pointIndex index) {
+		return pointX[index];
+	}
+
+	inline double graph::getY(pointIndex index) {
+		return pointY[index];
+	}
+
+	inline double graph::getZ(pointIndex index) {
+		return pointZ[index];
+	}
+
+	inline void graph::setZ(pointIndex index, double pz) {
+		pointZ[index] = pz;
+	}
+
+	inline const double* graph::getPointerToX() {
+		return pointX.data();
+	}
+
+	inline const double* graph::getPointerToY() {
+		return pointY.data();
+	}
+
+	inline const double* graph::getPointerToZ() {
+		return pointZ.data();
+	}
+
+	inline size_t graph::getEdgeNum() {
+		return origin.size();
+	}
+
+	inline pointIndex graph::getP1(edgeIndex e) {
+		return origin[e];
+	}
+
+	inline pointIndex graph::getP2(edgeIndex e) {
+		if (next[e] == NULL_EDGE) return origin[twin[e]];//edge without faces
+		return origin[next[e]];
+	}
+
+	inline pointIndex graph::getP3(edgeIndex e) {
+		return origin[prev[e]];
+	}
+
+	inline edgeIndex graph::getPairEdge(edgeIndex e) {
+		return twin[e];
+	}
+
+	inline edgeIndex graph::getPrevEdge(edgeIndex e) {
+		return prev[e];
+	}
+
+	inline edgeIndex graph::getNextEdge(edgeIndex e) {
+		return next[e];
+	}
+
+	inline void graph::setFlag(edgeIndex e, bool f) {
+		marks[e] = f ? epoch : 0;
+	}
+
+	inline bool graph::getFlag(edgeIndex e) {
+		return marks[e] == epoch;
+	}
+}
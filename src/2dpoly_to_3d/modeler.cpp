@@ -11,191 +11,468 @@
 
 #include "modeler.hpp"
 
+//SIMD for normal calculation (AVX: 4 doubles, SSE2: 2 doubles, or scalar)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MODELER_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MODELER_SSE2
+#endif
+
 namespace sketch3D {
 
 	modeler::modeler(graph::graph* graph)
 		:baseGraphHandler(graph, "modeler"), 
-		faceNum(), faces() {}
+		faceNum(), faces(), seamPointNum(0), ringNum(1),
+		edgeRing(), ringEdges(), ringSin(), ringCos(), triangles(), ringPointBase(0),
+		spineZ(), spineCount(),
+		faceNormalX(), faceNormalY(), faceNormalZ(),
+		normalX(), normalY(), normalZ(),
+		vertexFaceOffset(), vertexFaces(), normalsAreValid(false) {}
 
 
 	size_t modeler::getFaceNum() {
 		return faceNum;
 	}
 
-	graph::point* obalMid(graph::point* p1, graph::point* p2) {
-		graph::point* pa, * pb, *dummy;
-		pa = p1;
-		pb = p2;
-		if (p1->getZ() != 0) {
-			dummy = pa;
-			pa = pb;
-			pb = dummy;
-		}
-		double pax = pa->getX();
-		double pay = pa->getY();
-		double pbx = pb->getX();
-		double pby = pb->getY();
-		double vecx = pax - pbx;
-		double vecy = pay - pby;
-		double b = pb->getZ();
-		double sin_half_pi = sin(M_PI / 4);
+	size_t modeler::getSeamPointNum() {
+		return seamPointNum;
+	}
+
+	size_t modeler::getModelPointNum(bool mirrored) {
+		size_t pointNum = getPointNum();
+		return mirrored ? pointNum * 2 - seamPointNum : pointNum;
+	}
+
+	size_t modeler::getModelFaceNum(bool mirrored) {
+		return mirrored ? faceNum * 2 : faceNum;
+	}
+
+	void modeler::setRingNum(size_t num) {
+		ringNum = num < 1 ? 1 : num;
+	}
 
-		return new graph::point(pbx+vecx*sin_half_pi, pby+vecy*sin_half_pi, b*sin_half_pi);
+	size_t modeler::getRingNum() {
+		return ringNum;
 	}
 
 	void modeler::calZ(size_t outer_pnum) {
-		graph::edge* e;
-		graph::point* p1 = nullptr, * p2 = nullptr, * mid;
+		graph::edgeIndex e;
 		size_t p1id, p2id;
 		size_t edgeNum = getEdgeNum();
 		size_t pointNum = getPointNum();
 		size_t spinePointNum = pointNum - outer_pnum;
-		double* z = new double[spinePointNum];
-		int* count = new int[spinePointNum];
-		for (size_t i = 0; i < spinePointNum; i++) {
-			z[i] = 0.0;
-			count[i] = 0;
-		}
+		spineZ.assign(spinePointNum, 0.0);
+		spineCount.assign(spinePointNum, 0);
 
 		for (size_t i = 0; i < edgeNum; i++) {
-			e = getEdge(i);
-			p1 = e->getP1();
-			p2 = e->getP2();
-			p1id = p1->getID();
-			p2id = p2->getID();
+			e = (graph::edgeIndex)i;
+			directedGraph->getPointID(e, &p1id, &p2id);
 			if (p1id >= outer_pnum && p2id < outer_pnum) {
-				z[p1id - outer_pnum] += e->len();
-				count[p1id - outer_pnum] += 1;
+				spineZ[p1id - outer_pnum] += directedGraph->len(e);
+				spineCount[p1id - outer_pnum] += 1;
 			}
 		}
 		for (size_t i = 0; i < spinePointNum; i++) {
-			p1 = getPoint(i+outer_pnum);
-			p1->setZ(z[i]/(double)count[i]);
+			directedGraph->setZ((graph::pointIndex)(i + outer_pnum), spineZ[i] / (double)spineCount[i]);
 		}
-
-		delete[] z;
-		delete[] count;
 	}
 
-	void modeler::smoothing(size_t outer_pnum) {
-		calZ(outer_pnum);
-		size_t point_size = getPointNum();
-		graph::edge* e;
-		graph::point* p1=nullptr, * p2= nullptr, * mid;
-		size_t p1id, p2id;
+	void modeler::addRingPoints(size_t outer_pnum) {
+		//finds edges spine->outline (and their pairs)
 		size_t edgeNum = getEdgeNum();
+		edgeRing.assign(edgeNum, UINT32_MAX);
+		ringEdges.clear();
+		graph::edgeIndex e, pair;
+		size_t p1id, p2id;
 		for (size_t i = 0; i < edgeNum; i++) {
-			e = getEdge(i);
-			p1 = e->getP1();
-			p2 = e->getP2();
-			p1id = p1->getID();
-			p2id = p2->getID();
-			if (p1id >= outer_pnum && p2id < outer_pnum ) {
-				mid = obalMid(p1,p2);
-				addPointObject(mid);
-				directedGraph->insertPoint2(mid, e);
+			e = (graph::edgeIndex)i;
+			directedGraph->getPointID(e, &p1id, &p2id);
+			if (p1id >= outer_pnum && p2id < outer_pnum) {
+				edgeRing[e] = (uint32_t)(ringEdges.size() / 2);
+				pair = directedGraph->getPairEdge(e);
+				if (pair != graph::NULL_EDGE) edgeRing[pair] = edgeRing[e];
+				ringEdges.push_back((graph::pointIndex)p1id);
+				ringEdges.push_back((graph::pointIndex)p2id);
+			}
+		}
+
+		//angles of ring points (0 at spine, pi/2 at outline)
+		ringSin.resize(ringNum);
+		ringCos.resize(ringNum);
+		double theta;
+		for (size_t k = 0; k < ringNum; k++) {
+			theta = (double)(k + 1) * (M_PI / 2) / (double)(ringNum + 1);
+			ringSin[k] = sin(theta);
+			ringCos[k] = cos(theta);
+		}
+
+		//points on quarter ellipses (spine.xy + (outline.xy - spine.xy) * sin, spine.z * cos)
+		ringPointBase = (graph::pointIndex)getPointNum();
+		size_t splitNum = ringEdges.size() / 2;
+		double sx, sy, sz, vx, vy;
+		graph::pointIndex sp, op;
+		for (size_t i = 0; i < splitNum; i++) {
+			sp = ringEdges[i * 2];
+			op = ringEdges[i * 2 + 1];
+			sx = directedGraph->getX(sp);
+			sy = directedGraph->getY(sp);
+			sz = directedGraph->getZ(sp);
+			vx = directedGraph->getX(op) - sx;
+			vy = directedGraph->getY(op) - sy;
+			for (size_t k = 0; k < ringNum; k++) {
+				directedGraph->addPoint(sx + vx * ringSin[k], sy + vy * ringSin[k], sz * ringCos[k]);
 			}
-			
 		}
 	}
 
-	void modeler::mirrorZ(size_t outer_pnum) {
-		size_t point_size = getPointNum();
-		for (size_t i = 0; i < point_size - outer_pnum; i++) {
-			graph::point* p = getPoint(outer_pnum+i);
-			addPointObject(new graph::point(p->getX(), p->getY(), -p->getZ(), point_size + i));
+	graph::pointIndex modeler::getRingPoint(graph::edgeIndex e, size_t k) {
+		uint32_t split = edgeRing[e];
+		graph::pointIndex first = ringPointBase + (graph::pointIndex)(split * ringNum);
+		if (directedGraph->getP1(e) == ringEdges[split * 2]) {
+			return first + (graph::pointIndex)(k - 1);//from spine
+		}
+		return first + (graph::pointIndex)(ringNum - k);//from outline
+	}
+
+	void modeler::addQuad(graph::pointIndex a, graph::pointIndex b, graph::pointIndex c, graph::pointIndex d) {
+		graph::point pa = getPoint(a), pb = getPoint(b), pc = getPoint(c), pd = getPoint(d);
+		//quads are convex (their points are on two edges of a triangle)
+		if (squaredDistance(pa, pc) <= squaredDistance(pb, pd)) {
+			triangles.insert(triangles.end(), { a, b, c, a, c, d });
+		}
+		else {
+			triangles.insert(triangles.end(), { a, b, d, b, c, d });
 		}
-		size_t p1,p2,p3;
-		size_t i3;
-		faces.resize(faceNum*6);
-		for (size_t i = 0; i < faceNum;i++) {
-			i3 = i * 3;
-			p1 = faces[i3];
-			p2 = faces[i3 + 1];
-			p3 = faces[i3 + 2];
+	}
+
+	void modeler::rebuildFaces() {
+		size_t faceNum = directedGraph->getFaceNum();
+		triangles.clear();
+		triangles.reserve(faceNum * (ringNum + 1) * 2 * 3);
+
+		graph::edgeIndex e[3];
+		graph::pointIndex c, u, w, q1, q2, r1, r2;
+		int splitNum, side;
+		for (size_t i = 0; i < faceNum; i++) {
+			e[0] = directedGraph->getFaceEdge(i);
+			e[1] = directedGraph->getNextEdge(e[0]);
+			e[2] = directedGraph->getNextEdge(e[1]);
+			splitNum = 0;
+			side = 0;
+			for (int j = 0; j < 3; j++) {
+				if (edgeRing[e[j]] != UINT32_MAX) splitNum++;
+				else side = j;
+			}
 
-			if (p1 >= outer_pnum) {
-				p1 += point_size - outer_pnum;
+			if (splitNum == 0) {
+				triangles.insert(triangles.end(),
+					{ directedGraph->getP1(e[0]), directedGraph->getP1(e[1]), directedGraph->getP1(e[2]) });
+			}
+			else if (splitNum == 2) {
+				//c is the point between split edges (c->u and w->c). u->w is not split.
+				//c, q1, r1 is a triangle, and the others are quads between rings.
+				c = directedGraph->getP1(e[(side + 2) % 3]);
+				u = directedGraph->getP1(e[side]);
+				w = directedGraph->getP1(e[(side + 1) % 3]);
+				q1 = getRingPoint(e[(side + 2) % 3], 1);
+				r1 = getRingPoint(e[(side + 1) % 3], ringNum);
+				triangles.insert(triangles.end(), { c, q1, r1 });
+				for (size_t k = 1; k < ringNum; k++) {
+					q2 = getRingPoint(e[(side + 2) % 3], k + 1);
+					r2 = getRingPoint(e[(side + 1) % 3], ringNum - k);
+					addQuad(q1, q2, r2, r1);
+					q1 = q2;
+					r1 = r2;
+				}
+				addQuad(q1, u, w, r1);
 			}
-			if (p2 >= outer_pnum) {
-				p2 += point_size - outer_pnum;
+			else if (splitNum == 1) {
+				//a fan from the opposite point
+				for (int j = 0; j < 3; j++) {
+					if (edgeRing[e[j]] != UINT32_MAX) side = j;
+				}
+				c = directedGraph->getP3(e[side]);
+				q1 = directedGraph->getP1(e[side]);
+				for (size_t k = 1; k <= ringNum; k++) {
+					q2 = getRingPoint(e[side], k);
+					triangles.insert(triangles.end(), { q1, q2, c });
+					q1 = q2;
+				}
+				triangles.insert(triangles.end(), { q1, directedGraph->getP2(e[side]), c });
 			}
-			if (p3 >= outer_pnum) {
-				p3 += point_size - outer_pnum;
+			else {
+				throw graph::graphException("modeler", "smoothing: all edges of a face are between spine and outline");
 			}
-			faces[faceNum * 3 + i3] = p2;
-			faces[faceNum * 3 + i3+1] = p1;
-			faces[faceNum * 3 + i3 + 2] = p3;
-			
+		}
 
+		//rebuilds all edges at once
+		directedGraph->clearEdges();
+		size_t triangleNum = triangles.size() / 3;
+		for (size_t i = 0; i < triangleNum; i++) {
+			directedGraph->addFace(triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2]);
 		}
-		faceNum = faceNum * 2;
-	
+		directedGraph->makePairs();
 	}
 
+	void modeler::smoothing(size_t outer_pnum) {
+		calZ(outer_pnum);
+		addRingPoints(outer_pnum);
+		rebuildFaces();
+	}
 
-	void modeler::getPointsFacesNormals(double* point_coords, size_t* face_IDs, double* normals) {
-		size_t size = getPointNum();
-		if (size < 3) return;
+	void modeler::calFaceNormals() {
+		faceNormalX.resize(faceNum);
+		faceNormalY.resize(faceNum);
+		faceNormalZ.resize(faceNum);
+		const double* x = directedGraph->getPointerToX();
+		const double* y = directedGraph->getPointerToY();
+		const double* z = directedGraph->getPointerToZ();
+		const size_t* f = faces.data();
+		double* nx = faceNormalX.data();
+		double* ny = faceNormalY.data();
+		double* nz = faceNormalZ.data();
 
-		getPoints(point_coords);
+		//n = (p1 - p3) X (p2 - p3) (same as calNormal without normalization)
+		//|n| is twice the area of the face, so the sum of n is weighted by area.
+		size_t i = 0;
+#if defined(MODELER_AVX)
+		for (; i + 4 <= faceNum; i += 4) {
+			const size_t* fi = f + i * 3;
+			__m256d ax, ay, az, bx, by, bz, cx, cy, cz;
+			cx = _mm256_set_pd(x[fi[11]], x[fi[8]], x[fi[5]], x[fi[2]]);
+			cy = _mm256_set_pd(y[fi[11]], y[fi[8]], y[fi[5]], y[fi[2]]);
+			cz = _mm256_set_pd(z[fi[11]], z[fi[8]], z[fi[5]], z[fi[2]]);
+			ax = _mm256_sub_pd(_mm256_set_pd(x[fi[9]], x[fi[6]], x[fi[3]], x[fi[0]]), cx);
+			ay = _mm256_sub_pd(_mm256_set_pd(y[fi[9]], y[fi[6]], y[fi[3]], y[fi[0]]), cy);
+			az = _mm256_sub_pd(_mm256_set_pd(z[fi[9]], z[fi[6]], z[fi[3]], z[fi[0]]), cz);
+			bx = _mm256_sub_pd(_mm256_set_pd(x[fi[10]], x[fi[7]], x[fi[4]], x[fi[1]]), cx);
+			by = _mm256_sub_pd(_mm256_set_pd(y[fi[10]], y[fi[7]], y[fi[4]], y[fi[1]]), cy);
+			bz = _mm256_sub_pd(_mm256_set_pd(z[fi[10]], z[fi[7]], z[fi[4]], z[fi[1]]), cz);
+			_mm256_storeu_pd(nx + i, _mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by)));
+			_mm256_storeu_pd(ny + i, _mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz)));
+			_mm256_storeu_pd(nz + i, _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx)));
+		}
+#elif defined(MODELER_SSE2)
+		for (; i + 2 <= faceNum; i += 2) {
+			const size_t* fi = f + i * 3;
+			__m128d ax, ay, az, bx, by, bz, cx, cy, cz;
+			cx = _mm_set_pd(x[fi[5]], x[fi[2]]);
+			cy = _mm_set_pd(y[fi[5]], y[fi[2]]);
+			cz = _mm_set_pd(z[fi[5]], z[fi[2]]);
+			ax = _mm_sub_pd(_mm_set_pd(x[fi[3]], x[fi[0]]), cx);
+			ay = _mm_sub_pd(_mm_set_pd(y[fi[3]], y[fi[0]]), cy);
+			az = _mm_sub_pd(_mm_set_pd(z[fi[3]], z[fi[0]]), cz);
+			bx = _mm_sub_pd(_mm_set_pd(x[fi[4]], x[fi[1]]), cx);
+			by = _mm_sub_pd(_mm_set_pd(y[fi[4]], y[fi[1]]), cy);
+			bz = _mm_sub_pd(_mm_set_pd(z[fi[4]], z[fi[1]]), cz);
+			_mm_storeu_pd(nx + i, _mm_sub_pd(_mm_mul_pd(ay, bz), _mm_mul_pd(az, by)));
+			_mm_storeu_pd(ny + i, _mm_sub_pd(_mm_mul_pd(az, bx), _mm_mul_pd(ax, bz)));
+			_mm_storeu_pd(nz + i, _mm_sub_pd(_mm_mul_pd(ax, by), _mm_mul_pd(ay, bx)));
+		}
+#endif
+		double ax, ay, az, bx, by, bz;
+		size_t p1, p2, p3;
+		for (; i < faceNum; i++) {
+			p1 = f[i * 3];
+			p2 = f[i * 3 + 1];
+			p3 = f[i * 3 + 2];
+			ax = x[p1] - x[p3];
+			ay = y[p1] - y[p3];
+			az = z[p1] - z[p3];
+			bx = x[p2] - x[p3];
+			by = y[p2] - y[p3];
+			bz = z[p2] - z[p3];
+			nx[i] = ay * bz - az * by;
+			ny[i] = az * bx - ax * bz;
+			nz[i] = ax * by - ay * bx;
+		}
+	}
 
-		for (size_t i = 0; i < size * 3; i++) {
-			normals[i] = 0;
+	void modeler::buildVertexFaces(size_t pointNum) {
+		//counts faces of each vertex, and makes offsets by a prefix sum
+		vertexFaceOffset.assign(pointNum + 1, 0);
+		for (size_t i = 0; i < faceNum * 3; i++) {
+			vertexFaceOffset[faces[i] + 1]++;
+		}
+		for (size_t i = 0; i < pointNum; i++) {
+			vertexFaceOffset[i + 1] += vertexFaceOffset[i];
 		}
-		graph::point *p1, *p2, *p3;
-		size_t p1id, p2id, p3id;
-		double normal[3];
 
+		//fills faces (vertexFaceOffset[i] is used as a cursor and restored after that)
+		vertexFaces.resize(faceNum * 3);
+		size_t p;
 		for (size_t i = 0; i < faceNum * 3; i++) {
-			face_IDs[i] = faces[i];
+			p = faces[i];
+			vertexFaces[vertexFaceOffset[p]] = i / 3;
+			vertexFaceOffset[p]++;
+		}
+		for (size_t i = pointNum; i > 0; i--) {
+			vertexFaceOffset[i] = vertexFaceOffset[i - 1];
 		}
+		vertexFaceOffset[0] = 0;
+	}
 
-		
-		//face_IDs = &faces[0];
-		size_t i3;
-		for (size_t i = 0; i < faceNum; i++) {
-			i3 = i * 3;
-			p1id = faces[i3];
-			p2id = faces[i3 + 1];
-			p3id = faces[i3 + 2];
-			
+	void modeler::calVertexNormals(size_t pointNum) {
+		normalX.resize(pointNum);
+		normalY.resize(pointNum);
+		normalZ.resize(pointNum);
 
-			p1 = getPoint(p1id);
-			p2 = getPoint(p2id);
-			p3 = getPoint(p3id);
+		//gathers normals of faces (each vertex is written once, so there are no conflicts)
+		double sx, sy, sz;
+		size_t face;
+		for (size_t i = 0; i < pointNum; i++) {
+			sx = sy = sz = 0;
+			for (size_t j = vertexFaceOffset[i]; j < vertexFaceOffset[i + 1]; j++) {
+				face = vertexFaces[j];
+				sx += faceNormalX[face];
+				sy += faceNormalY[face];
+				sz += faceNormalZ[face];
+			}
+			normalX[i] = sx;
+			normalY[i] = sy;
+			normalZ[i] = sz;
+		}
 
-			calNormal(p1, p2, p3, normal);
-			normals[p1id * 3] += normal[0];
-			normals[p1id * 3 + 1] += normal[1];
-			normals[p1id * 3 + 2] += normal[2];
-			normals[p2id * 3] += normal[0];
-			normals[p2id * 3 + 1] += normal[1];
-			normals[p2id * 3 + 2] += normal[2];
-			normals[p3id * 3] += normal[0];
-			normals[p3id * 3 + 1] += normal[1];
-			normals[p3id * 3 + 2] += normal[2];
+		//seam points are shared with the mirrored half, so z of their normals cancels out.
+		for (size_t i = 0; i < seamPointNum && i < pointNum; i++) {
+			normalZ[i] = 0;
+		}
 
+		//normalizes them (zero vectors are kept)
+		double* nx = normalX.data();
+		double* ny = normalY.data();
+		double* nz = normalZ.data();
+		size_t i = 0;
+#if defined(MODELER_AVX)
+		__m256d vx, vy, vz, len, zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+		__m256d inv;
+		for (; i + 4 <= pointNum; i += 4) {
+			vx = _mm256_loadu_pd(nx + i);
+			vy = _mm256_loadu_pd(ny + i);
+			vz = _mm256_loadu_pd(nz + i);
+			len = _mm256_sqrt_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, vx), _mm256_mul_pd(vy, vy)), _mm256_mul_pd(vz, vz)));
+			inv = _mm256_and_pd(_mm256_div_pd(one, len), _mm256_cmp_pd(len, zero, _CMP_GT_OQ));
+			_mm256_storeu_pd(nx + i, _mm256_mul_pd(vx, inv));
+			_mm256_storeu_pd(ny + i, _mm256_mul_pd(vy, inv));
+			_mm256_storeu_pd(nz + i, _mm256_mul_pd(vz, inv));
+		}
+#elif defined(MODELER_SSE2)
+		__m128d vx, vy, vz, len, zero = _mm_setzero_pd(), one = _mm_set1_pd(1.0);
+		__m128d inv;
+		for (; i + 2 <= pointNum; i += 2) {
+			vx = _mm_loadu_pd(nx + i);
+			vy = _mm_loadu_pd(ny + i);
+			vz = _mm_loadu_pd(nz + i);
+			len = _mm_sqrt_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy)), _mm_mul_pd(vz, vz)));
+			inv = _mm_and_pd(_mm_div_pd(one, len), _mm_cmpgt_pd(len, zero));
+			_mm_storeu_pd(nx + i, _mm_mul_pd(vx, inv));
+			_mm_storeu_pd(ny + i, _mm_mul_pd(vy, inv));
+			_mm_storeu_pd(nz + i, _mm_mul_pd(vz, inv));
 		}
-		/*
-		for (size_t i = 0; i < size/2; i++) {
-			printf("(%f,%f,%f)\n", normals[i*3],normals[i*3+1],normals[i*3+2]);
+#endif
+		double l, invL;
+		for (; i < pointNum; i++) {
+			l = sqrt(nx[i] * nx[i] + ny[i] * ny[i] + nz[i] * nz[i]);
+			invL = l > 0 ? 1.0 / l : 0;
+			nx[i] *= invL;
+			ny[i] *= invL;
+			nz[i] *= invL;
 		}
-		*/
+	}
+
+	void modeler::calNormals() {
+		if (normalsAreValid) return;
+		size_t size = getPointNum();
+		calFaceNormals();
+		buildVertexFaces(size);
+		calVertexNormals(size);
+		normalsAreValid = true;
+	}
+
+	template <typename real, typename index>
+	void modeler::writeModel(real* point_coords, index* face_IDs, real* normals, bool mirrored) {
+		size_t size = getPointNum();
+		if (size < 3) return;
+
+		//mirrored points (x, y, -z) are appended after the points (seam points are shared)
+		size_t mirrorOffset = size - seamPointNum;
+		if (point_coords != nullptr) {
+			const double* x = directedGraph->getPointerToX();
+			const double* y = directedGraph->getPointerToY();
+			const double* z = directedGraph->getPointerToZ();
+			for (size_t i = 0; i < size; i++) {
+				point_coords[i * 3] = (real)x[i];
+				point_coords[i * 3 + 1] = (real)y[i];
+				point_coords[i * 3 + 2] = (real)z[i];
+			}
+			if (mirrored) {
+				real* mirror = point_coords + size * 3;
+				for (size_t i = seamPointNum; i < size; i++) {
+					mirror[(i - seamPointNum) * 3] = (real)x[i];
+					mirror[(i - seamPointNum) * 3 + 1] = (real)y[i];
+					mirror[(i - seamPointNum) * 3 + 2] = (real)-z[i];
+				}
+			}
+		}
+
+		//mirrored faces are (p2, p1, p3) to keep the normals outside
+		if (face_IDs != nullptr) {
+			for (size_t i = 0; i < faceNum * 3; i++) {
+				face_IDs[i] = (index)faces[i];
+			}
+			if (mirrored) {
+				index* mirror = face_IDs + faceNum * 3;
+				size_t p[3];
+				for (size_t i = 0; i < faceNum; i++) {
+					for (size_t j = 0; j < 3; j++) {
+						p[j] = faces[i * 3 + j];
+						if (p[j] >= seamPointNum) {
+							p[j] += mirrorOffset;
+						}
+					}
+					mirror[i * 3] = (index)p[1];
+					mirror[i * 3 + 1] = (index)p[0];
+					mirror[i * 3 + 2] = (index)p[2];
+				}
+			}
+		}
+
+		if (normals != nullptr) {
+			calNormals();
+			for (size_t i = 0; i < size; i++) {
+				normals[i * 3] = (real)normalX[i];
+				normals[i * 3 + 1] = (real)normalY[i];
+				normals[i * 3 + 2] = (real)normalZ[i];
+			}
+			if (mirrored) {
+				real* mirror = normals + size * 3;
+				for (size_t i = seamPointNum; i < size; i++) {
+					mirror[(i - seamPointNum) * 3] = (real)normalX[i];
+					mirror[(i - seamPointNum) * 3 + 1] = (real)normalY[i];
+					mirror[(i - seamPointNum) * 3 + 2] = (real)-normalZ[i];
+				}
+			}
+		}
+	}
+
+	void modeler::getPointsFacesNormals(double* point_coords, size_t* face_IDs, double* normals) {
+		writeModel(point_coords, face_IDs, normals, false);
+	}
+
+	void modeler::getPointsFacesNormals(float* point_coords, uint32_t* face_IDs, float* normals, bool mirrored) {
+		writeModel(point_coords, face_IDs, normals, mirrored);
 	}
 
 
 	void modeler::graphTo3D(size_t outer_pnum) {
 		faceNum = calFaceNum();
-		size_t* face_IDs = new size_t[faceNum * 3];
-		getFaces(face_IDs);
 		faces.resize(faceNum * 3);
-		for (size_t i = 0; i < faceNum * 3; i++) {
-			faces[i] = face_IDs[i];
-		}
-		//faces = std::vector<size_t>(face_IDs, face_IDs+(int)(faceNum*3));
-		delete[] face_IDs;
+		getFaces(faces.data());
 
-		mirrorZ(outer_pnum);
+		//the -z half is not stored. (points on the outline are the seam)
+		seamPointNum = outer_pnum;
+		normalsAreValid = false;
 	}
 }
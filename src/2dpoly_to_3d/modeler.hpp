@@ -26,17 +26,86 @@ namespace sketch3D {
 	private:
 		size_t faceNum;
 		std::vector<size_t> faces;
+		size_t seamPointNum;// points[0, seamPointNum) are on z=0 and shared with the mirrored half
+		size_t ringNum;// the number of points inserted in each edge between spine and outline
+
+		//work buffers of smoothing
+		std::vector<uint32_t> edgeRing;// index of the split edge in ringEdges (UINT32_MAX for other edges)
+		std::vector<graph::pointIndex> ringEdges;// split edges {e1_spine, e1_outline, e2_spine, ...}
+		std::vector<double> ringSin, ringCos;// sin and cos of angles of ring points
+		std::vector<graph::pointIndex> triangles;// new faces
+		graph::pointIndex ringPointBase;// index of the first ring point
+
+		//work buffers of calZ (they keep their capacity between models)
+		std::vector<double> spineZ;
+		std::vector<int> spineCount;
+
+		//work buffers of getPointsFacesNormals
+		std::vector<double> faceNormalX, faceNormalY, faceNormalZ;// area weighted (not normalized)
+		std::vector<double> normalX, normalY, normalZ;// vertex normals
+		std::vector<size_t> vertexFaceOffset;// faces of vertex i are vertexFaces[vertexFaceOffset[i]...vertexFaceOffset[i+1]-1]
+		std::vector<size_t> vertexFaces;
+		bool normalsAreValid;// normalX, Y and Z are for the current model
+
 		void calZ(size_t outer_pnum);
-		void mirrorZ(size_t outer_pnum);
+
+		//adds ring points on edges between spine and outline (on quarter ellipses)
+		void addRingPoints(size_t outer_pnum);
+
+		//gets the k-th ring point (k = 1, ..., ringNum) on half edge e from its p1
+		graph::pointIndex getRingPoint(graph::edgeIndex e, size_t k);
+
+		//makes new faces with ring points and rebuilds edges
+		void rebuildFaces();
+
+		//adds triangles a->b->c and a->c->d (or a->b->d and b->c->d with the shorter diagonal)
+		void addQuad(graph::pointIndex a, graph::pointIndex b, graph::pointIndex c, graph::pointIndex d);
+
+		//calculates faceNormalX, Y and Z (SIMD if it's available)
+		void calFaceNormals();
+
+		//makes vertexFaceOffset and vertexFaces
+		void buildVertexFaces(size_t pointNum);
+
+		//sums normals of faces around each vertex and normalizes them (SIMD if it's available)
+		void calVertexNormals(size_t pointNum);
+
+		//calculates normalX, Y and Z if they are not valid
+		void calNormals();
+
+		//writes the model in the output types (see getPointsFacesNormals)
+		template <typename real, typename index>
+		void writeModel(real* point_coords, index* face_IDs, real* normals, bool mirrored);
 
 	public:
 		modeler(graph::graph* graph);
+
+		//inserts ringNum points in each edge between spine and outline, and makes faces with them.
+		//a cross section of the model will be a quarter ellipse with ringNum + 2 points.
 		void smoothing(size_t outer_pnum);
 
+		//ringNum for smoothing (1 or more, default 1)
+		void setRingNum(size_t num);
+		size_t getRingNum();
+
+		//makes faces of the +z half of the model.
+		//the -z half is its mirror image (z -> -z, p1 <-> p2) and shares the first outer_pnum points (seam).
 		void graphTo3D(size_t outer_pnum);
+		size_t getSeamPointNum();
+
+		//normals are area weighted averages of face normals (unit vectors)
 		void getPointsFacesNormals(double* point_coords, size_t* face_IDs, double* normals);
+
+		//writes the model to buffers directly (nullptr skips the buffer).
+		//if mirrored is true, the -z half is appended (getModelPointNum(true) points and getModelFaceNum(true) faces)
+		void getPointsFacesNormals(float* point_coords, uint32_t* face_IDs, float* normals, bool mirrored);
+
 		size_t getFaceNum();
 
+		//the number of points and faces in the output (with or without the -z half)
+		size_t getModelPointNum(bool mirrored);
+		size_t getModelFaceNum(bool mirrored);
+
 	};
 
 
@@ -1,58 +1,143 @@
 /*
  * File: point.hpp
  * --------------------
+ * This file contains a point as a value and geometry helpers.
+ *
+ * Everything is inline and nothing touches the heap.
+ * graph stores coordinates as arrays, and points are made only when they are needed.
+ *
  * Author: Matyalatte
  * Last updated: 2021/09/25
  */
 #pragma once
 
+#include <cstddef>
+#include <cmath>
+
 namespace graph{
 
+	//a point as a value (coordinates are stored in graph as arrays)
 	class point {
 	private:
 		double x;
 		double y;
 		double z;
-		size_t index;
 
 	public:
-		point(double px, double py, double pz = 0, size_t id = 0);
-		void setXYZ(double px, double py, double pz = 0);
-		double getX();
-		double getY();
-		double getZ();
-		void setZ(double pz);
-		void setID(size_t id);
-		size_t getID();
+		point(double px = 0, double py = 0, double pz = 0) :x(px), y(py), z(pz) {}
+
+		void setXYZ(double px, double py, double pz = 0) {
+			x = px;
+			y = py;
+			z = pz;
+		}
+
+		double getX() const { return x; }
+		double getY() const { return y; }
+		double getZ() const { return z; }
+		void setZ(double pz) { z = pz; }
 	};
 
 	//c->a X c->b
-	double crossprod2D(point* a, point* b, point* c);
+	inline double crossprod2D(const point& a, const point& b, const point& c) {
+		return (a.getX() - c.getX()) * (b.getY() - c.getY()) - (b.getX() - c.getX()) * (a.getY() - c.getY());
+	}
 
 	//calcurate normal vector (normalize(c->a X c->b))
-	void calNormal(point* a,point* b,point* c, double* normal);
+	inline void calNormal(const point& a, const point& b, const point& c, double* normal) {
+		double ax = a.getX() - c.getX();
+		double ay = a.getY() - c.getY();
+		double az = a.getZ() - c.getZ();
+		double bx = b.getX() - c.getX();
+		double by = b.getY() - c.getY();
+		double bz = b.getZ() - c.getZ();
+		normal[0] = ay * bz - az * by;
+		normal[1] = az * bx - ax * bz;
+		normal[2] = ax * by - ay * bx;
+		double d = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		normal[0] = normal[0] / d;
+		normal[1] = normal[1] / d;
+		normal[2] = normal[2] / d;
+	}
 
 	//c->a * c->b
-	double innerprod2D(point* a, point* b, point* c);
+	inline double innerprod2D(const point& a, const point& b, const point& c) {
+		return (a.getX() - c.getX()) * (b.getX() - c.getX()) + (b.getY() - c.getY()) * (a.getY() - c.getY());
+	}
 
 	//|a->b|^2
-	double squaredDistance(point* a, point* b);
+	inline double squaredDistance(const point& a, const point& b) {
+		double x = a.getX() - b.getX();
+		double y = a.getY() - b.getY();
+		return x * x + y * y;
+	}
 
 	//|a->b|
-	double distance(point* a, point* b);
-
-	//square p1->p2->p3->p4->p1 is convex or not
-	bool isConvexSquare(point* p1, point* p2, point* p3, point* p4);
-
-	//edge p1->p2 crosses edge p3->p4 or not
-	bool isCross(point* p1, point* p2, point* p3, point* p4);
+	inline double distance(const point& a, const point& b) {
+		return sqrt(squaredDistance(a, b));
+	}
 
 	//mid point between p1 and p2
-	point* mid(point* p1, point* p2);
+	inline point mid(const point& p1, const point& p2) {
+		return point((p1.getX() + p2.getX()) / 2, (p1.getY() + p2.getY()) / 2);
+	}
 
 	//center point of the set (p1, p2, p3)
-	point* center(point* p1, point* p2, point* p3);
+	inline point center(const point& p1, const point& p2, const point& p3) {
+		return point((p1.getX() + p2.getX() + p3.getX()) / 3,
+			(p1.getY() + p2.getY() + p3.getY()) / 3);
+	}
+
+	//a circle that includes all added points.
+	//it grows incrementally (like Ritter's bounding sphere), so it's not the smallest one.
+	class boundingCircle {
+	private:
+		double x;
+		double y;
+		double r;
+		bool empty;
+
+	public:
+		boundingCircle() :x(0), y(0), r(0), empty(true) {}
+
+		void clear() {
+			empty = true;
+		}
+
+		void add(const point& p) {
+			if (empty) {
+				x = p.getX();
+				y = p.getY();
+				r = 0;
+				empty = false;
+				return;
+			}
+			double dx = p.getX() - x;
+			double dy = p.getY() - y;
+			double d = sqrt(dx * dx + dy * dy);
+			if (d <= r) return;
+
+			//moves the center toward p
+			double newR = (r + d) / 2;
+			x += dx * (newR - r) / d;
+			y += dy * (newR - r) / d;
+			r = newR;
+		}
+
+		//all added points are in the circle with diameter p1->p2.
+		//false doesn't mean that a point is outside (the margin covers rounding errors)
+		bool isInDiametralCircle(const point& p1, const point& p2) const {
+			if (empty) return true;
+			point m = mid(p1, p2);
+			double radius = distance(p1, p2) / 2;
+			double margin = 1e-9 * (radius + std::abs(m.getX()) + std::abs(m.getY()));
+			return distance(m, point(x, y)) + r + margin <= radius;
+		}
+	};
 
 	//target is in a circle or not. p1 and p2 are on the circle. p1->p2 is the diameter of the circle
-	bool isInCircle(point* target, point* p1, point* p2);
-}
\ No newline at end of file
+	//(the angle p1-target-p2 is not acute. no square roots)
+	inline bool isInCircle(const point& target, const point& p1, const point& p2) {
+		return innerprod2D(p1, p2, target) <= 0;
+	}
+}
@@ -0,0 +1,131 @@
+/*
+ * File: pool.hpp
+ * --------------------
+ * This file contains a simple object pool and a memory arena.
+ *
+ * Objects are allocated from fixed size chunks and released all at once by reset().
+ * Chunks are kept after reset() and reused by the next allocations.
+ * Destructors are never called, so T should be trivially destructible.
+ * arenaAllocator lets node based containers (e.g. std::set) use an arena in the same way.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace sketch3D {
+
+	template <class T, size_t CHUNK_SIZE = 256>
+	class pool {
+		static_assert(std::is_trivially_destructible<T>::value, "pool: T should be trivially destructible");
+
+	private:
+		typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type slot;
+
+		std::vector<slot*> chunks;
+		size_t chunkID;// index of the current chunk
+		size_t used;// number of used slots in the current chunk
+
+	public:
+		pool() :chunks(), chunkID(0), used(0) {}
+
+		~pool() {
+			for (size_t i = 0; i < chunks.size(); i++) {
+				delete[] chunks[i];
+			}
+		}
+
+		pool(const pool&) = delete;
+		pool& operator=(const pool&) = delete;
+
+		//construct an object in the pool
+		template <class... Args>
+		T* alloc(Args&&... args) {
+			if (used == CHUNK_SIZE) {
+				chunkID++;
+				used = 0;
+			}
+			if (chunkID == chunks.size()) chunks.push_back(new slot[CHUNK_SIZE]);
+			return new(&chunks[chunkID][used++]) T(std::forward<Args>(args)...);
+		}
+
+		//release all objects (memory is kept for reuse)
+		void reset() {
+			chunkID = 0;
+			used = 0;
+		}
+	};
+
+	//raw memory for small objects
+	class arena {
+	private:
+		static const size_t CHUNK_SIZE = 16384;
+		static const size_t ALIGN = alignof(std::max_align_t);
+		typedef std::aligned_storage<CHUNK_SIZE, ALIGN>::type chunk;
+
+		std::vector<chunk*> chunks;
+		size_t chunkID;// index of the current chunk
+		size_t used;// number of used bytes in the current chunk
+
+	public:
+		arena() :chunks(), chunkID(0), used(0) {}
+
+		~arena() {
+			for (size_t i = 0; i < chunks.size(); i++) {
+				delete chunks[i];
+			}
+		}
+
+		arena(const arena&) = delete;
+		arena& operator=(const arena&) = delete;
+
+		//get memory aligned to max_align_t
+		void* alloc(size_t size) {
+			size = (size + ALIGN - 1) / ALIGN * ALIGN;
+			if (size > CHUNK_SIZE) throw std::bad_alloc();
+			if (used + size > CHUNK_SIZE) {
+				chunkID++;
+				used = 0;
+			}
+			if (chunkID == chunks.size()) chunks.push_back(new chunk);
+			void* p = reinterpret_cast<char*>(chunks[chunkID]) + used;
+			used += size;
+			return p;
+		}
+
+		//release all memory (it's kept for reuse)
+		void reset() {
+			chunkID = 0;
+			used = 0;
+		}
+	};
+
+	//allocator for STL containers (deallocate does nothing. memory is released by arena::reset())
+	template <class T>
+	class arenaAllocator {
+	public:
+		typedef T value_type;
+		arena* memory;
+
+		arenaAllocator(arena* memory) :memory(memory) {}
+		template <class U>
+		arenaAllocator(const arenaAllocator<U>& other) :memory(other.memory) {}
+
+		T* allocate(size_t n) {
+			return static_cast<T*>(memory->alloc(sizeof(T) * n));
+		}
+		void deallocate(T*, size_t) {}
+
+		template <class U>
+		bool operator==(const arenaAllocator<U>& other) const { return memory == other.memory; }
+		template <class U>
+		bool operator!=(const arenaAllocator<U>& other) const { return memory != other.memory; }
+	};
+}
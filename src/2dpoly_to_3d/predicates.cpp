@@ -0,0 +1,218 @@
+/*
+ * File: predicates.cpp
+ * --------------------
+ * Exact arithmetic is based on J. R. Shewchuk,
+ * "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates".
+ *
+ * An expansion is a sum of doubles sorted by increasing magnitude without overlapping bits.
+ * Its sign is the sign of the last (largest) component.
+ * Expansions are fixed size arrays on the stack (no heap allocation).
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+#include "predicates.hpp"
+#include <algorithm>
+
+namespace graph {
+
+	namespace {
+		const double SPLITTER = 134217729.0;// 2^27 + 1
+
+		//x + y = a + b exactly
+		inline void twoSum(double a, double b, double& x, double& y) {
+			x = a + b;
+			double bv = x - a;
+			double av = x - bv;
+			y = (a - av) + (b - bv);
+		}
+
+		//x + y = a + b exactly (|a| >= |b|)
+		inline void fastTwoSum(double a, double b, double& x, double& y) {
+			x = a + b;
+			y = b - (x - a);
+		}
+
+		//hi + lo = a
+		inline void split(double a, double& hi, double& lo) {
+			double c = SPLITTER * a;
+			hi = c - (c - a);
+			lo = a - hi;
+		}
+
+		//x + y = a * b exactly
+		inline void twoProduct(double a, double b, double& x, double& y) {
+			x = a * b;
+			double ahi, alo, bhi, blo;
+			split(a, ahi, alo);
+			split(b, bhi, blo);
+			y = alo * blo - (((x - ahi * bhi) - alo * bhi) - ahi * blo);
+		}
+
+		//a - b as an expansion (h has 2 components at most)
+		int diff(double a, double b, double* h) {
+			double x = a - b;
+			double bv = a - x;
+			double av = x + bv;
+			double y = (a - av) + (bv - b);
+			int hlen = 0;
+			if (y != 0) h[hlen++] = y;
+			if (x != 0 || hlen == 0) h[hlen++] = x;
+			return hlen;
+		}
+
+		//e + f (fast_expansion_sum_zeroelim, h has elen + flen components at most)
+		int sum(int elen, const double* e, int flen, const double* f, double* h) {
+			int ei = 0, fi = 0, hlen = 0;
+			double q, qNew, hh;
+			double eNow = e[0];
+			double fNow = f[0];
+			if ((fNow > eNow) == (fNow > -eNow)) {
+				q = eNow;
+				ei++;
+			}
+			else {
+				q = fNow;
+				fi++;
+			}
+			if (ei < elen && fi < flen) {
+				eNow = e[ei];
+				fNow = f[fi];
+				if ((fNow > eNow) == (fNow > -eNow)) {
+					fastTwoSum(eNow, q, qNew, hh);
+					ei++;
+				}
+				else {
+					fastTwoSum(fNow, q, qNew, hh);
+					fi++;
+				}
+				q = qNew;
+				if (hh != 0) h[hlen++] = hh;
+				while (ei < elen && fi < flen) {
+					eNow = e[ei];
+					fNow = f[fi];
+					if ((fNow > eNow) == (fNow > -eNow)) {
+						twoSum(q, eNow, qNew, hh);
+						ei++;
+					}
+					else {
+						twoSum(q, fNow, qNew, hh);
+						fi++;
+					}
+					q = qNew;
+					if (hh != 0) h[hlen++] = hh;
+				}
+			}
+			for (; ei < elen; ei++) {
+				twoSum(q, e[ei], qNew, hh);
+				q = qNew;
+				if (hh != 0) h[hlen++] = hh;
+			}
+			for (; fi < flen; fi++) {
+				twoSum(q, f[fi], qNew, hh);
+				q = qNew;
+				if (hh != 0) h[hlen++] = hh;
+			}
+			if (q != 0 || hlen == 0) h[hlen++] = q;
+			return hlen;
+		}
+
+		//e * b (scale_expansion_zeroelim, h has elen * 2 components at most)
+		int scale(int elen, const double* e, double b, double* h) {
+			int hlen = 0;
+			double q, hh, product1, product0, s;
+			twoProduct(e[0], b, q, hh);
+			if (hh != 0) h[hlen++] = hh;
+			for (int i = 1; i < elen; i++) {
+				twoProduct(e[i], b, product1, product0);
+				twoSum(q, product0, s, hh);
+				if (hh != 0) h[hlen++] = hh;
+				fastTwoSum(product1, s, q, hh);
+				if (hh != 0) h[hlen++] = hh;
+			}
+			if (q != 0 || hlen == 0) h[hlen++] = q;
+			return hlen;
+		}
+
+		//e * f (h has elen * flen * 2 components at most, elen <= MUL_MAX_LEN, elen * flen * 2 <= MUL_MAX_RESULT)
+		const int MUL_MAX_LEN = 16;
+		const int MUL_MAX_RESULT = 512;
+		int mul(int elen, const double* e, int flen, const double* f, double* h) {
+			double part[MUL_MAX_LEN * 2];
+			double acc[MUL_MAX_RESULT];
+			int hlen = scale(elen, e, f[0], h);
+			int partLen, accLen;
+			for (int i = 1; i < flen; i++) {
+				partLen = scale(elen, e, f[i], part);
+				accLen = sum(hlen, h, partLen, part, acc);
+				std::copy(acc, acc + accLen, h);
+				hlen = accLen;
+			}
+			return hlen;
+		}
+
+		//-e
+		void neg(int elen, double* e) {
+			for (int i = 0; i < elen; i++) e[i] = -e[i];
+		}
+
+		//e * f - g * k for 2 component expansions (h has 16 components at most)
+		int crossDiff(int elen, const double* e, int flen, const double* f,
+			int glen, const double* g, int klen, const double* k, double* h) {
+			double ef[8], gk[8];
+			int efLen = mul(elen, e, flen, f, ef);
+			int gkLen = mul(glen, g, klen, k, gk);
+			neg(gkLen, gk);
+			return sum(efLen, ef, gkLen, gk, h);
+		}
+
+		//e * e + f * f for 2 component expansions (h has 16 components at most)
+		int squaredLen(int elen, const double* e, int flen, const double* f, double* h) {
+			double ee[8], ff[8];
+			int eeLen = mul(elen, e, elen, e, ee);
+			int ffLen = mul(flen, f, flen, f, ff);
+			return sum(eeLen, ee, ffLen, ff, h);
+		}
+	}
+
+	double orient2DExact(const point& a, const point& b, const point& c) {
+		double acx[2], acy[2], bcx[2], bcy[2];
+		int acxLen = diff(a.getX(), c.getX(), acx);
+		int acyLen = diff(a.getY(), c.getY(), acy);
+		int bcxLen = diff(b.getX(), c.getX(), bcx);
+		int bcyLen = diff(b.getY(), c.getY(), bcy);
+		double det[16];
+		int detLen = crossDiff(acxLen, acx, bcyLen, bcy, acyLen, acy, bcxLen, bcx, det);
+		return det[detLen - 1];
+	}
+
+	double inCircleExact(const point& a, const point& b, const point& c, const point& d) {
+		double adx[2], ady[2], bdx[2], bdy[2], cdx[2], cdy[2];
+		int adxLen = diff(a.getX(), d.getX(), adx);
+		int adyLen = diff(a.getY(), d.getY(), ady);
+		int bdxLen = diff(b.getX(), d.getX(), bdx);
+		int bdyLen = diff(b.getY(), d.getY(), bdy);
+		int cdxLen = diff(c.getX(), d.getX(), cdx);
+		int cdyLen = diff(c.getY(), d.getY(), cdy);
+
+		double bc[16], ca[16], ab[16];
+		int bcLen = crossDiff(bdxLen, bdx, cdyLen, cdy, cdxLen, cdx, bdyLen, bdy, bc);
+		int caLen = crossDiff(cdxLen, cdx, adyLen, ady, adxLen, adx, cdyLen, cdy, ca);
+		int abLen = crossDiff(adxLen, adx, bdyLen, bdy, bdxLen, bdx, adyLen, ady, ab);
+
+		double alift[16], blift[16], clift[16];
+		int aliftLen = squaredLen(adxLen, adx, adyLen, ady, alift);
+		int bliftLen = squaredLen(bdxLen, bdx, bdyLen, bdy, blift);
+		int cliftLen = squaredLen(cdxLen, cdx, cdyLen, cdy, clift);
+
+		double adet[512], bdet[512], cdet[512];
+		int adetLen = mul(aliftLen, alift, bcLen, bc, adet);
+		int bdetLen = mul(bliftLen, blift, caLen, ca, bdet);
+		int cdetLen = mul(cliftLen, clift, abLen, ab, cdet);
+
+		double abdet[1024], det[1536];
+		int abdetLen = sum(adetLen, adet, bdetLen, bdet, abdet);
+		int detLen = sum(abdetLen, abdet, cdetLen, cdet, det);
+		return det[detLen - 1];
+	}
+}
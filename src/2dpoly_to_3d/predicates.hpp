@@ -0,0 +1,104 @@
+/*
+ * File: predicates.hpp
+ * --------------------
+ * This file contains robust geometric predicates.
+ *
+ * Each predicate evaluates the determinant with doubles first,
+ * and recomputes it with exact arithmetic (floating-point expansions)
+ * only when the rounding error can change the sign (Shewchuk's filter).
+ * The returned value has the correct sign, but its magnitude can be approximate.
+ *
+ * The filters are inline. See predicates.cpp for the exact arithmetic.
+ * Each predicate takes an optional counter (exactNum) that is incremented when exact arithmetic is used.
+ * Graph handlers pass the counter of their graph, so the count belongs to the model's context.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+#pragma once
+
+#include "point.hpp"
+#include <cmath>
+
+namespace graph {
+
+	const double PREDICATE_EPSILON = 1.1102230246251565e-16;// 2^-53
+	const double ORIENT_ERRBOUND = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+	const double INCIRCLE_ERRBOUND = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+
+	//orient2D and inCircle with exact arithmetic (slow)
+	double orient2DExact(const point& a, const point& b, const point& c);
+	double inCircleExact(const point& a, const point& b, const point& c, const point& d);
+
+	//c->a X c->b with the exact sign (same as crossprod2D)
+	//>0: a->b->c is counterclockwise, =0: collinear, <0: clockwise
+	inline double orient2D(const point& a, const point& b, const point& c, size_t* exactNum = nullptr) {
+		double detLeft = (a.getX() - c.getX()) * (b.getY() - c.getY());
+		double detRight = (a.getY() - c.getY()) * (b.getX() - c.getX());
+		double det = detLeft - detRight;
+
+		//the sign is correct if |det| is larger than the error bound
+		double errBound = ORIENT_ERRBOUND * (std::abs(detLeft) + std::abs(detRight));
+		if (det > errBound || -det > errBound) return det;
+
+		if (exactNum != nullptr) (*exactNum)++;
+		return orient2DExact(a, b, c);
+	}
+
+	//>0: d is in the circumscribed circle of a->b->c (counterclockwise), =0: on the circle, <0: outside
+	inline double inCircle(const point& a, const point& b, const point& c, const point& d, size_t* exactNum = nullptr) {
+		double adx = a.getX() - d.getX();
+		double ady = a.getY() - d.getY();
+		double bdx = b.getX() - d.getX();
+		double bdy = b.getY() - d.getY();
+		double cdx = c.getX() - d.getX();
+		double cdy = c.getY() - d.getY();
+
+		double bdxcdy = bdx * cdy;
+		double cdxbdy = cdx * bdy;
+		double alift = adx * adx + ady * ady;
+
+		double cdxady = cdx * ady;
+		double adxcdy = adx * cdy;
+		double blift = bdx * bdx + bdy * bdy;
+
+		double adxbdy = adx * bdy;
+		double bdxady = bdx * ady;
+		double clift = cdx * cdx + cdy * cdy;
+
+		double det = alift * (bdxcdy - cdxbdy)
+			+ blift * (cdxady - adxcdy)
+			+ clift * (adxbdy - bdxady);
+
+		//the sign is correct if |det| is larger than the error bound
+		double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift
+			+ (std::abs(cdxady) + std::abs(adxcdy)) * blift
+			+ (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+		double errBound = INCIRCLE_ERRBOUND * permanent;
+		if (det > errBound || -det > errBound) return det;
+
+		if (exactNum != nullptr) (*exactNum)++;
+		return inCircleExact(a, b, c, d);
+	}
+
+	//square p1->p2->p3->p4->p1 is convex or not
+	inline bool isConvexSquare(const point& p1, const point& p2, const point& p3, const point& p4, size_t* exactNum = nullptr) {
+		//all corners turn in the same direction
+		bool s1 = orient2D(p1, p2, p3, exactNum) > 0;
+		bool s2 = orient2D(p2, p3, p4, exactNum) > 0;
+		bool s3 = orient2D(p3, p4, p1, exactNum) > 0;
+		bool s4 = orient2D(p4, p1, p2, exactNum) > 0;
+		return s1 == s2 && s2 == s3 && s3 == s4;
+	}
+
+	//edge p1->p2 crosses edge p3->p4 or not
+	inline bool isCross(const point& p1, const point& p2, const point& p3, const point& p4, size_t* exactNum = nullptr) {
+		//compares signs (products of tiny values can underflow)
+		double o1 = orient2D(p2, p3, p1, exactNum);
+		double o2 = orient2D(p2, p4, p1, exactNum);
+		if (o1 == 0 || o2 == 0 || (o1 > 0) == (o2 > 0)) return false;
+		double o3 = orient2D(p4, p1, p3, exactNum);
+		double o4 = orient2D(p4, p2, p3, exactNum);
+		return o3 != 0 && o4 != 0 && (o3 > 0) != (o4 > 0);
+	}
+}
@@ -11,17 +11,17 @@
 
 namespace sketch3D {
 
-	spine::spine(graph::edge* e1_, graph::edge* e2_, graph::point* p1_, graph::point* p2_)
-		:s(), flag(false)
+	spine::spine(graph::edgeIndex e1_, graph::edgeIndex e2_, graph::pointIndex p1_, graph::pointIndex p2_)
+		:s(), mark(0)
 	{
 		e1 = e1_;
 		e2 = e2_;
 		p1 = p1_;
 		p2 = p2_;
-		if (e2_ == nullptr) {
+		if (e2_ == graph::NULL_EDGE) {
 			spineType = SPINE_TYPE_TERMINAL;
 		}
-		else if (e1_ == nullptr) {
+		else if (e1_ == graph::NULL_EDGE) {
 			spineType = SPINE_TYPE_JOINT;
 		}
 		else {
@@ -32,27 +32,17 @@ namespace sketch3D {
 		s[2] = nullptr;
 	}
 
-	void spine::setPoint(graph::point* p1_, graph::point* p2_) {
+	void spine::setPoint(graph::pointIndex p1_, graph::pointIndex p2_) {
 		p1 = p1_;
 		p2 = p2_;
 	}
-	void spine::getPoint(graph::point* p1_, graph::point* p2_) {
-		p1_ = p1;
-		p2_ = p2;
-	}
 
-	graph::point* spine::getP1() {
+	graph::pointIndex spine::getP1() {
 		return p1;
 	}
-	graph::point* spine::getP2() {
+	graph::pointIndex spine::getP2() {
 		return p2;
 	}
-	void spine::getCoord(double* coord) {
-		coord[0] = p1->getX();
-		coord[1] = p1->getY();
-		coord[2] = p2->getX();
-		coord[3] = p2->getY();
-	}
 
 	void spine::setSpine(spine* s_, size_t index) {
 		if (index==3) index = s[0] == nullptr ? 0 : 1;
@@ -67,8 +57,8 @@ namespace sketch3D {
 		b = c;
 	}
 
-	void spine::changeToJoint(graph::point* p1_, graph::edge* e2_, graph::point* p2_) {
-		e1 = nullptr;
+	void spine::changeToJoint(graph::pointIndex p1_, graph::edgeIndex e2_, graph::pointIndex p2_) {
+		e1 = graph::NULL_EDGE;
 		e2 = e2_;
 		p1 = p1_;
 		p2 = p2_;
@@ -78,25 +68,29 @@ namespace sketch3D {
 	int spine::getType() {
 		return spineType;
 	}
-	graph::edge* spine::getE1() {
+	graph::edgeIndex spine::getE1() {
 		return e1;
 	}
-	graph::edge* spine::getE2() {
+	graph::edgeIndex spine::getE2() {
 		return e2;
 	}
+	void spine::setEdge(graph::edgeIndex e1_, graph::edgeIndex e2_) {
+		e1 = e1_;
+		e2 = e2_;
+	}
 	spine* spine::getOppositeSpine(spine* s_) {
 		return s[0] == s_ ? s[1] : s[0];
 	}
 
-	graph::edge* spine::getOppositeEdge(graph::edge* e_) {
+	graph::edgeIndex spine::getOppositeEdge(graph::edgeIndex e_) {
 		return e1 == e_ ? e2 : e1;
 	}
 
-	void spine::setFlag(bool f) {
-		flag = f;
+	void spine::setMark(uint32_t m) {
+		mark = m;
 	}
-	bool spine::getFlag() {
-		return flag;
+	uint32_t spine::getMark() {
+		return mark;
 	}
 
 	void connectSpine(spine* s1, spine* s2) {
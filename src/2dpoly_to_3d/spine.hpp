@@ -9,6 +9,7 @@
 #pragma once
 
 #include "edge.hpp"
+#include <cstdint>
 
 namespace sketch3D {
 
@@ -20,53 +21,50 @@ namespace sketch3D {
 	//joint->...->p1->p2->...->terminal
 	class spine {
 	private:
-		graph::edge* e1, *e2;//e1=null then joint, e2=null then terminal
-		graph::point* p1, * p2;//p1:mid point of e1, p2:mid point of e2
+		graph::edgeIndex e1, e2;//e1=null then joint, e2=null then terminal
+		graph::pointIndex p1, p2;//p1:mid point of e1, p2:mid point of e2
 		spine* s[3];//connected spines ...->s1->p1->this->p2->s2->... s3 is for joint spines.
 
 		int spineType; //type0:normal spine, 1:joint spine, 2:terminal spine
-		bool flag;
+		uint32_t mark;//spineEstimator's flag (true if mark == its epoch)
 	public:
-		spine(graph::edge* e1_, graph::edge* e2_=nullptr, graph::point* p1_=nullptr, graph::point* p2_ = nullptr);
+		spine(graph::edgeIndex e1_, graph::edgeIndex e2_ = graph::NULL_EDGE, graph::pointIndex p1_ = graph::NULL_POINT, graph::pointIndex p2_ = graph::NULL_POINT);
 		
 		//set points
-		void setPoint(graph::point* p1_, graph::point* p2_ = nullptr);
-
-		//get points
-		void getPoint(graph::point* p1_, graph::point* p2_ = nullptr);
+		void setPoint(graph::pointIndex p1_, graph::pointIndex p2_ = graph::NULL_POINT);
 
 		//get p1
-		graph::point* getP1();
+		graph::pointIndex getP1();
 
 		//get p2
-		graph::point* getP2();
-
-		//get coordinates of spine
-		void getCoord(double* coord_);
+		graph::pointIndex getP2();
 
 		//set connected spine
 		void setSpine(spine* s_, size_t index=3);
 
 		//change this spine to joint type spine
-		void changeToJoint(graph::point* p1_, graph::edge* e2_, graph::point* p2_);
+		void changeToJoint(graph::pointIndex p1_, graph::edgeIndex e2_, graph::pointIndex p2_);
 
 		//get type
 		int getType();
 
 		//get e1
-		graph::edge* getE1();
+		graph::edgeIndex getE1();
 
 		//get e2
-		graph::edge* getE2();
+		graph::edgeIndex getE2();
+
+		//set e1 and e2 (e.g. when edge indices are shifted)
+		void setEdge(graph::edgeIndex e1_, graph::edgeIndex e2_);
 
 		//get the spine opposite s_
 		spine* getOppositeSpine(spine* s_);
 
 		//get the spine opposite e_
-		graph::edge* getOppositeEdge(graph::edge* e_);
+		graph::edgeIndex getOppositeEdge(graph::edgeIndex e_);
 
-		void setFlag(bool f=false);
-		bool getFlag();
+		void setMark(uint32_t m = 0);
+		uint32_t getMark();
 	};
 
 	void connectSpine(spine* s1, spine* s2);
@@ -7,83 +7,67 @@
  */
 
 #include "spineEstimator.hpp"
+#include "predicates.hpp"
 
 namespace sketch3D {
 
 	spineEstimator::spineEstimator(graph::graph* graph)
 		:baseGraphHandler(graph, "spineEstimator"),
-		spines(), pointNum(0) {}
+		spines(), spinePool(), pointNum(0), spineEpoch(1), spineTasks(),
+		faceStack(), fanPoints(), edgeRemap(), pointRemap(), pointFlags() {}
 
-	spineEstimator::~spineEstimator() {
-		for (size_t i = 0; i < getSpineNum(); i++) {
-			delete spines[i];
-		}
-	}
+	spineEstimator::~spineEstimator() {}
 
-	void spineEstimator::addSpine(graph::edge* e1, graph::edge* e2, graph::point* p1, graph::point* p2) {
-		spines.push_back(new spine(e1, e2, p1, p2));
+	void spineEstimator::addSpine(graph::edgeIndex e1, graph::edgeIndex e2, graph::pointIndex p1, graph::pointIndex p2) {
+		spines.push_back(spinePool.alloc(e1, e2, p1, p2));
 	}
 
 	void spineEstimator::init() {
 		spines.resize(0);
-		spines.shrink_to_fit();
+		spinePool.reset();
 		pointNum = getPointNum();
 	}
 
-	/*In the following case, this method will not count the edges crossing correctly.
-	* @:point, -:edge
-	*
-	*               |
-	*               |
-	* @-----@=======@----@
-	*       |
-	*       |
-	*
-	*/
+	bool spineEstimator::isPolygonEdge(graph::edgeIndex e) {
+		size_t p1_id, p2_id;
+		size_t point_size = getPointNum();
+		directedGraph->getPointID(e, &p1_id, &p2_id);
+		return (p1_id + 1) % point_size == p2_id || (p2_id + 1) % point_size == p1_id;
+	}
+
+	//external faces are found by a flood fill from the faces deleted with the super triangle.
+	//the fill stops at edges of the polygon.
 	void spineEstimator::deleteExternalEdge() {
-		double maxX = directedGraph->getMaxX();
 		size_t point_size = getPointNum();
 		size_t edge_size = getEdgeNum();
-		graph::edge* e;
-		graph::point* p1;
-		graph::point* p2;
-		graph::point* p3;
-		graph::point* p4;
-		size_t p1_id;
-		size_t p2_id;
-
-		int count;
+		graph::edgeIndex e, f, pair;
+		while (!faceStack.empty()) faceStack.pop();
 
 		directedGraph->resetFlag();
+
+		//faces next to the super triangle (convex hull edges that are not polygon edges)
 		for (size_t i = 0; i < edge_size; i++) {
-			e = getEdge(i);
-			if (e->getFlag()) continue;
-
-			p1 = e->getP1();
-			p2 = e->getP2();
-			e->getPointID(&p1_id, &p2_id);
-
-			//if edge e is an outer edge then continue
-			if ((p1_id + 1) % point_size == p2_id || (p2_id + 1) % point_size == p1_id) continue;
-
-			graph::point* mid = graph::mid(p1, p2);
-			graph::point* end = new graph::point(directedGraph->getMaxX() + 1.0, mid->getY());
-
-			//check edge e is an external edge or not.
-			count = 0;
-			for (size_t j = 0; j < point_size; j++) {
-				p3 = getPoint(j);
-				p4 = getPoint((j + 1) * (int)(j + 1 < point_size));
-				if (graph::isCross(mid, end, p3, p4)) count += 1;
-
-				double p3x = p3->getX();
-				double p3y = p3->getY();
-				if (p3y == mid->getY() && mid->getX() <= p3x && p3x <= end->getX()) {
-					double y = getPoint(((int)j - 1 + point_size) % point_size)->getY();
-					if ((p4->getY() - p3y) * (y - p3y) < 0) count += 1;
+			e = (graph::edgeIndex)i;
+			if (directedGraph->getFlag(e)) continue;
+			if (directedGraph->getPairEdge(e) != graph::NULL_EDGE || isPolygonEdge(e)) continue;
+			setFlagToFace(e);//edge e is external!
+			faceStack.push(e);
+		}
+
+		//spreads to neighbor faces
+		while (!faceStack.empty()) {
+			e = faceStack.top();
+			faceStack.pop();
+			f = e;
+			for (int i = 0; i < 3; i++) {
+				pair = directedGraph->getPairEdge(f);
+				if (pair != graph::NULL_EDGE && !directedGraph->getFlag(pair) && !isPolygonEdge(f)) {
+					setFlagToFace(pair);
+					faceStack.push(pair);
 				}
+				f = directedGraph->getPrevEdge(f);
+				if (f == graph::NULL_EDGE) break;
 			}
-			if (count % 2 == 0) setFlagToFace(e);//edge e is external!
 		}
 
 		//delete external edges
@@ -94,56 +78,52 @@ namespace sketch3D {
 	}
 
 	//generate spines
-	void spineEstimator::genSpineFromChordalAxisRec(graph::edge* e, graph::point* p, spine* s) {
-		graph::edge* prev = e->getPrevEdge();
-		graph::edge* next = prev->getPrevEdge();
-		graph::edge* pair = e->getPairEdge();
+	void spineEstimator::genSpineFromChordalAxisStep(graph::edgeIndex e, graph::pointIndex p, spine* s) {
+		graph::edgeIndex prev = directedGraph->getPrevEdge(e);
+		graph::edgeIndex next = directedGraph->getPrevEdge(prev);
+		graph::edgeIndex pair = directedGraph->getPairEdge(e);
 
-		if (pair == nullptr) {//outer edge
-			if (p == nullptr) genSpineFromChordalAxisRec(prev);
+		if (pair == graph::NULL_EDGE) {//outer edge
+			if (p == graph::NULL_POINT) pushSpineTask(prev);
 			return;
 		}
 
-		graph::point* mid;
+		graph::pointIndex mid;
 
-		if (p == nullptr) {
-			mid = e->getMidPoint();
-			directedGraph->addPointObject(mid);
+		if (p == graph::NULL_POINT) {
+			mid = addPoint(directedGraph->getMidPoint(e));
 		}
 		else {
 			mid = p;
 		}
-		graph::point* p3;
+		graph::pointIndex p3;
 		spine* newS;
 
-		bool prevPairIsNull = prev->getPairEdge() == nullptr;
-		bool nextPairIsNull = next->getPairEdge() == nullptr;
+		bool prevPairIsNull = directedGraph->getPairEdge(prev) == graph::NULL_EDGE;
+		bool nextPairIsNull = directedGraph->getPairEdge(next) == graph::NULL_EDGE;
 		if (prevPairIsNull && nextPairIsNull) {
 			//gen terminal spine
-			p3 = e->getP3();
-			addSpine(e, nullptr, mid, p3);
+			p3 = directedGraph->getP3(e);
+			addSpine(e, graph::NULL_EDGE, mid, p3);
 			newS = getLastSpine();
 			if (s != nullptr) connectSpine(s, newS);
 		}
 		else if (!prevPairIsNull && !nextPairIsNull) {
-			graph::point* mid2, * mid3;
+			graph::pointIndex mid2, mid3;
 			spine* s2, * s3;
 
 			//gen joint spine
-			p3 = e->getCenterPoint();
-			addPointObject(p3);
-			addSpine(nullptr, e, p3, mid);
+			p3 = addPoint(directedGraph->getCenterPoint(e));
+			addSpine(graph::NULL_EDGE, e, p3, mid);
 			newS = getLastSpine();
 			if (s != nullptr) connectSpine(s, newS);
 
-			mid2 = prev->getMidPoint();
-			addPointObject(mid2);
-			addSpine(nullptr, prev, p3, mid2);
+			mid2 = addPoint(directedGraph->getMidPoint(prev));
+			addSpine(graph::NULL_EDGE, prev, p3, mid2);
 			s2 = getLastSpine();
 
-			mid3 = next->getMidPoint();
-			addPointObject(mid3);
-			addSpine(nullptr, next, p3, mid3);
+			mid3 = addPoint(directedGraph->getMidPoint(next));
+			addSpine(graph::NULL_EDGE, next, p3, mid3);
 			s3 = getLastSpine();
 
 			s2->setSpine(newS);
@@ -151,58 +131,80 @@ namespace sketch3D {
 			s3->setSpine(newS);
 			s3->setSpine(s2, 2);
 
-			genSpineFromChordalAxisRec(prev->getPairEdge(), mid2, s2);
-			genSpineFromChordalAxisRec(next->getPairEdge(), mid3, s3);
-
-			directedGraph->insertPoint(p3, e);
+			//tasks run in reverse order (prev side -> next side -> insertion)
+			if (p == graph::NULL_POINT) pushSpineTask(pair, mid, newS);
+			pushSpineTask(e, p3, nullptr, true);
+			pushSpineTask(directedGraph->getPairEdge(next), mid3, s3);
+			pushSpineTask(directedGraph->getPairEdge(prev), mid2, s2);
+			return;
 		}
 		else {
 			//gen normal spine
-			graph::edge* e2;
+			graph::edgeIndex e2;
 			if (prevPairIsNull) {
 				e2 = next;
 			}
 			else {
 				e2 = prev;
 			}
-			p3 = e2->getMidPoint();
-			addPointObject(p3);
+			p3 = addPoint(directedGraph->getMidPoint(e2));
 			addSpine(e, e2, mid, p3);
 			newS = getLastSpine();
 			if (s != nullptr) connectSpine(s, newS);
-			genSpineFromChordalAxisRec(e2->getPairEdge(), p3, newS);
-		}
-		if (p == nullptr) {
-			genSpineFromChordalAxisRec(pair, mid, newS);
+			if (p == graph::NULL_POINT) pushSpineTask(pair, mid, newS);
+			pushSpineTask(directedGraph->getPairEdge(e2), p3, newS);
+			return;
 		}
+		if (p == graph::NULL_POINT) pushSpineTask(pair, mid, newS);
 	}
 
+	void spineEstimator::pushSpineTask(graph::edgeIndex e, graph::pointIndex p, spine* s, bool insert) {
+		spineTask task;
+		task.e = e;
+		task.p = p;
+		task.s = s;
+		task.insert = insert;
+		spineTasks.push_back(task);
+	}
+
+	//traverses faces with an explicit stack (a long stroke makes a long chain of faces)
 	void spineEstimator::genSpineFromChordalAxis() {
-		genSpineFromChordalAxisRec(getEdge(0));
+		spineTasks.resize(0);
+		pushSpineTask(0);
+		spineTask task;
+		while (!spineTasks.empty()) {
+			task = spineTasks.back();
+			spineTasks.pop_back();
+			if (task.insert) {
+				directedGraph->insertPoint(task.p, task.e);
+			}
+			else {
+				genSpineFromChordalAxisStep(task.e, task.p, task.s);
+			}
+		}
 	}
 
 
-	void spineEstimator::genFanTriangle(graph::point* p1, graph::point* p2, graph::point* center, size_t pnum, graph::edge* se_prev, graph::edge* se_next) {
+	void spineEstimator::genFanTriangle(graph::pointIndex p1, graph::pointIndex p2, graph::pointIndex center, size_t pnum, graph::edgeIndex se_prev, graph::edgeIndex se_next) {
 		
-		graph::point* start, *next;
-		size_t centerID = center->getID();
-		if ((p1->getID() + pnum) % pointNum == p2->getID()) { start = p1;}
-		else if ((p2->getID() + pnum) % pointNum == p1->getID()) { start = p2;}
+		graph::pointIndex start;
+		if ((p1 + pnum) % pointNum == p2) { start = p1;}
+		else if ((p2 + pnum) % pointNum == p1) { start = p2;}
 		else { throw graph::graphException("spineEstimator", "genFanTriangleGen: unexpected parameters detected"); }
 
 		size_t edgesize = getEdgeNum();
-		next = getPoint((start->getID() + 1) % pointNum);
-		bool direction = graph::crossprod2D(start, next, center)>0;
+		graph::pointIndex next = (graph::pointIndex)((start + 1) % pointNum);
+		bool direction = graph::orient2D(getPoint(start), getPoint(next), getPoint(center), exactNum)>0;
 
 		for (size_t i = 0; i < pnum; i++) {
-			directedGraph->addFace((start->getID() + i+!direction) % pointNum, (start->getID() + i + direction) % pointNum, centerID);
+			directedGraph->addFace((start + i+!direction) % pointNum, (start + i + direction) % pointNum, center);
 		}
 		for (size_t i = 0; i < pnum-1; i++) {
 			directedGraph->makePair(edgesize + 1 + i * 3+ !direction, edgesize + 5 + i * 3-!direction);
 		}
 
-		if (se_prev != nullptr) {
-			graph::edge* e, *pe, * ne;
+		if (se_prev != graph::NULL_EDGE) {
+			graph::edgeIndex pe, ne;
 			if (direction) {
 				pe = se_prev;
 				ne = se_next;
@@ -211,96 +213,107 @@ namespace sketch3D {
 				pe = se_next;
 				ne = se_prev;
 			}
-			e = getEdge(edgesize + 2 - !direction);
-			e->setPairEdge(pe);
-			pe->setPairEdge(e);
-
-			e = getEdge(edgesize + 1 + (pnum - 1) * 3 + !direction);
-			e->setPairEdge(ne);
-			ne->setPairEdge(e);
+			directedGraph->makePair((graph::edgeIndex)(edgesize + 2 - !direction), pe);
+			directedGraph->makePair((graph::edgeIndex)(edgesize + 1 + (pnum - 1) * 3 + !direction), ne);
 		}
 	}
 
-	void spineEstimator::genFanTriangleRec(graph::edge* e, std::vector<graph::point*>& pvec, spine* s, spine* preS, bool end) {
+	void spineEstimator::genFanTriangleRec(graph::edgeIndex e, std::vector<graph::pointIndex>& pvec, graph::boundingCircle& pcircle, spine* s, spine* preS, bool end) {
+		//walks along the spines from a terminal (a loop instead of a tail call, so long strokes don't overflow the stack)
+		while (true) {
+			//if s is joint then generate fan triangle
+			if (s->getType() == SPINE_TYPE_JOINT) {
+				setSpineFlag(s);
 
-		//if s is joint then generate fan triangle
-		if (s->getType() == SPINE_TYPE_JOINT) {
-			s->setFlag(true);
+				graph::edgeIndex s_e = s->getOppositeEdge(graph::NULL_EDGE);
+				if (s_e == graph::NULL_EDGE) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected edge detected");
+				setFlagToFace(s_e);
+				graph::edgeIndex prev = directedGraph->getPrevEdge(s_e);
+				graph::edgeIndex next = directedGraph->getPrevEdge(prev);
 
-			graph::edge* s_e = s->getOppositeEdge(nullptr);
-			if (s_e == nullptr) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected edge detected");
-			setFlagToFace(s_e);
-			graph::edge* prev = s_e->getPrevEdge();
-			graph::edge* next = prev->getPrevEdge();
-			
-			genFanTriangle(s_e->getP1(), s_e->getP2(), s->getP1(), pvec.size() + 1, prev->getPairEdge(), next->getPairEdge());
+				genFanTriangle(directedGraph->getP1(s_e), directedGraph->getP2(s_e), s->getP1(), pvec.size() + 1, directedGraph->getPairEdge(prev), directedGraph->getPairEdge(next));
 
-			prev->setPairEdge(nullptr);
-			next->setPairEdge(nullptr);
+				directedGraph->setPairEdge(prev);
+				directedGraph->setPairEdge(next);
 
-			return;
-		}
+				return;
+			}
 
-		
-		graph::point* p1 = e->getP1();
-		graph::point* p2 = e->getP2();
-		graph::edge* pair = e->getPairEdge();
+			if (e == graph::NULL_EDGE) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected edge detected");
+			graph::pointIndex p1 = directedGraph->getP1(e);
+			graph::pointIndex p2 = directedGraph->getP2(e);
+			graph::edgeIndex pair = directedGraph->getPairEdge(e);
 
-		bool flag = false;
+			bool flag = false;
 
 
-		graph::point* p3 = e->getP3();
-		pvec.push_back(p3);
+			graph::pointIndex p3 = directedGraph->getP3(e);
+			pvec.push_back(p3);
+			pcircle.add(getPoint(p3));
 
-		graph::point* p;
-		if (end) {
-			graph::edge* e2;
-			graph::point* s_p2;
-			if (s->getE1() == e) { e2 = s->getE2(); p = s->getP2(); s_p2 = s->getP1(); }
-			else {
-				if (s->getE2() == nullptr) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected edge detected");
-				p = s->getP1();
-				e2 = s->getE1();
-				s_p2 = s->getP2();
-			}
+			graph::pointIndex p;
+			if (end) {
+				graph::edgeIndex e2;
+				graph::pointIndex s_p2;
+				if (s->getE1() == e) { e2 = s->getE2(); p = s->getP2(); s_p2 = s->getP1(); }
+				else {
+					if (s->getE2() == graph::NULL_EDGE) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected edge detected");
+					p = s->getP1();
+					e2 = s->getE1();
+					s_p2 = s->getP2();
+				}
 
-			p1 = e2->getP1();
-			p2 = e2->getP2();
-			pair = e2->getPairEdge();
-			if (p->getID() < pointNum) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected point index detected");
+				p1 = directedGraph->getP1(e2);
+				p2 = directedGraph->getP2(e2);
+				pair = directedGraph->getPairEdge(e2);
+				if (p < pointNum) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected point index detected");
 
-			pair->setPairEdge(nullptr);
-			e2->setPairEdge(nullptr);
+				directedGraph->setPairEdge(pair);
+				directedGraph->setPairEdge(e2);
 
-			directedGraph->insertPoint2(p, e2);
-			size_t edgeNum = getEdgeNum();
+				directedGraph->insertPoint2(p, e2);
+				size_t edgeNum = getEdgeNum();
 
-			genFanTriangle(p1, p2, p, pvec.size(), e2, getEdge(edgeNum - 2));
+				genFanTriangle(p1, p2, p, pvec.size(), e2, (graph::edgeIndex)(edgeNum - 2));
 
-			s->changeToJoint(p, e, s_p2);
-			return;
-		}
+				s->changeToJoint(p, e, s_p2);
+				return;
+			}
 
-		for (size_t i = 0; i < pvec.size(); i++) {
-			p = pvec[i];
-			if (!isInCircle(p, p1, p2)) {
-				flag = true;
-				break;
+			graph::point point1 = getPoint(p1);
+			graph::point point2 = getPoint(p2);
+
+			//checks the bounding circle of pvec first (a constant time accept).
+			//if it's inconclusive, pvec is scanned. a scan finding an outside point ends the fan,
+			//so the other scans visit all points: O(k^2) in the worst case for a fan of k faces
+			//whose points are near the diametral circle (e.g. a round end of a stroke).
+			//(in the test corpus, fans have 34 faces at most and a scan visits 11 points on average)
+			if (!pcircle.isInDiametralCircle(point1, point2)) {
+				for (size_t i = 0; i < pvec.size(); i++) {
+					if (!isInCircle(getPoint(pvec[i]), point1, point2)) {
+						flag = true;
+						break;
+					}
+				}
 			}
-		}
-		if (flag) {
-			if (s->getType() == SPINE_TYPE_TERMINAL) {
-				s->setFlag(true);
-				return;
+			if (flag) {
+				if (s->getType() == SPINE_TYPE_TERMINAL) {
+					setSpineFlag(s);
+					return;
+				}
+				end = true;
 			}
-			end = true;
-		}
-		s->setFlag(true);
+			setSpineFlag(s);
 
-		setFlagToFace(e);
-		spine* s2 = s->getOppositeSpine(preS);
-		graph::edge* e2 = s2->getOppositeEdge(pair);
-		genFanTriangleRec(e2, pvec, s2, s, end);
+			setFlagToFace(e);
+			spine* s2 = s->getOppositeSpine(preS);
+			if (s2 == nullptr) throw graph::graphException("spineEstimator", "genFanTriangleRec: unexpected spine detected");
+
+			//next face
+			e = s2->getOppositeEdge(pair);
+			preS = s;
+			s = s2;
+		}
 	}
 
 	void spineEstimator::searchSpineToGenFan() {
@@ -308,42 +321,67 @@ namespace sketch3D {
 		resetSpineFlag();
 
 		spine* s;
-		graph::edge* e;
-		std::vector<graph::point*> pvec;
+		graph::edgeIndex e;
+		graph::boundingCircle pcircle;
 
 		//find terminal edges
 		for (size_t i = 0; i < getSpineNum(); i++) {
 			s = spines[i];
 			if (s->getType() == SPINE_TYPE_TERMINAL) {
-				pvec.resize(0);
-				pvec.shrink_to_fit();
+				fanPoints.clear();
+				pcircle.clear();
 				e = s->getE1();
 				//generate fan triangles
-				genFanTriangleRec(e, pvec, s);
+				genFanTriangleRec(e, fanPoints, pcircle, s);
 			}
 		}
 
 		//delete unused edges and spines
-		deleteEdgeFlagIsTrue();
+		deleteEdgeFlagIsTrue(&edgeRemap);
 		deleteSpineFlagIsTrue();
+
+		//spines refer to edges by index, so shift them
+		graph::edgeIndex e1, e2;
+		for (size_t i = 0; i < getSpineNum(); i++) {
+			s = spines[i];
+			e1 = s->getE1();
+			e2 = s->getE2();
+			if (e1 != graph::NULL_EDGE) e1 = edgeRemap[e1];
+			if (e2 != graph::NULL_EDGE) e2 = edgeRemap[e2];
+			s->setEdge(e1, e2);
+		}
 	}
 
 	void spineEstimator::resetSpineFlag() {
-		for (size_t i = 0; i < getSpineNum(); i++) {
-			spines[i]->setFlag();
+		spineEpoch++;
+		if (spineEpoch == 0) {//wrapped around
+			for (size_t i = 0; i < getSpineNum(); i++) {
+				spines[i]->setMark();
+			}
+			spineEpoch = 1;
 		}
 	}
 
+	void spineEstimator::setSpineFlag(spine* s) {
+		s->setMark(spineEpoch);
+	}
+
+	bool spineEstimator::getSpineFlag(spine* s) {
+		return s->getMark() == spineEpoch;
+	}
+
 	void spineEstimator::deleteSpineFlagIsTrue() {
 		size_t spine_size = getSpineNum();
-		spine* s;
-		for (int i = (int)spine_size - 1; i >= 0; i--) {
-			s = spines[i];
-			if (s->getFlag()) {
-				delete s;
-				spines.erase(spines.begin() + i);
+		size_t count = 0;
+
+		//spines stay in the pool until init()
+		for (size_t i = 0; i < spine_size; i++) {
+			if (!getSpineFlag(spines[i])) {
+				spines[count] = spines[i];
+				count++;
 			}
 		}
+		spines.resize(count);
 	}
 
 	void spineEstimator::deleteUnusedPoint() {
@@ -351,28 +389,24 @@ namespace sketch3D {
 		size_t spine_size = getSpineNum();
 
 		spine* s;
-		size_t p1_id;
-		size_t p2_id;
-		bool* flag=new bool[point_size - pointNum];
-		for (size_t i = 0; i < point_size - pointNum; i++) {
-			flag[i] = true;
+		pointFlags.assign(point_size, false);
+		for (size_t i = pointNum; i < point_size; i++) {
+			pointFlags[i] = true;
 		}
 
 		for (size_t i = 0; i < spine_size; i++) {
 			s = spines[i];
-			p1_id = s->getP1()->getID();
-			p2_id=s->getP2()->getID();
-			flag[p1_id - pointNum] = false;
-			flag[p2_id - pointNum] = false;
+			pointFlags[s->getP1()] = false;
+			pointFlags[s->getP2()] = false;
 		}
 
-		for (int i = (int)point_size -1; i >= pointNum; i--) {
-			if (flag[(size_t)i-pointNum]) {
-				directedGraph->deletePoint(i);
-			}
+		directedGraph->deletePoints(pointFlags, &pointRemap);
+
+		//spines refer to points by index, so shift them
+		for (size_t i = 0; i < spine_size; i++) {
+			s = spines[i];
+			s->setPoint(pointRemap[s->getP1()], pointRemap[s->getP2()]);
 		}
-		directedGraph->resetPointID();
-		delete[] flag;
 	}
 	
 	void spineEstimator::splitFaceBySpine() {
@@ -383,24 +417,21 @@ namespace sketch3D {
 		size_t p1_id;
 		size_t p2_id;
 
-		bool* flag = new bool[point_size - pointNum];
-		for (size_t i = 0; i < point_size - pointNum; i++) {
-			flag[i] = false;
-		}
+		pointFlags.assign(point_size - pointNum, false);
 
 		for (size_t i = 0; i < spine_size; i++) {
 			s = spines[i];
 			
-			p1_id = s->getP1()->getID();
-			p2_id = s->getP2()->getID();
+			p1_id = s->getP1();
+			p2_id = s->getP2();
 
-			if (!flag[p2_id - pointNum]) {
+			if (!pointFlags[p2_id - pointNum]) {
 				directedGraph->insertPoint2(s->getP2(), s->getE2());
-				flag[p2_id-pointNum] = true;
+				pointFlags[p2_id - pointNum] = true;
 			}
-			if (s->getType() == SPINE_TYPE_NORMAL && !flag[p1_id - pointNum]) {
+			if (s->getType() == SPINE_TYPE_NORMAL && !pointFlags[p1_id - pointNum]) {
 				directedGraph->insertPoint2(s->getP1(), s->getE1());
-				flag[p1_id - pointNum] = true;
+				pointFlags[p1_id - pointNum] = true;
 			}
 		}
 
@@ -415,12 +446,15 @@ namespace sketch3D {
 		size_t size = spines.size();
 		if (size < 1) return;
 
-		double* coords = new double[4];
+		graph::pointIndex p1, p2;
 		for (size_t i = 0; i < size; i++) {
-			spines[i]->getCoord(coords);
-			memmove(&spine_coords[i*4], coords, sizeof(double)*4);
+			p1 = spines[i]->getP1();
+			p2 = spines[i]->getP2();
+			spine_coords[i * 4] = directedGraph->getX(p1);
+			spine_coords[i * 4 + 1] = directedGraph->getY(p1);
+			spine_coords[i * 4 + 2] = directedGraph->getX(p2);
+			spine_coords[i * 4 + 3] = directedGraph->getY(p2);
 		}
-		delete[] coords;
 	}
 
 	size_t spineEstimator::getSpineNum() {
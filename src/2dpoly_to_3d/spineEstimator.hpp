@@ -9,6 +9,7 @@
 
 #include "baseGraphHandler.hpp"
 #include "spine.hpp"
+#include "pool.hpp"
 //#include "exception.h"
 //#include "point.hpp"
 //#include "edge.hpp"
@@ -19,21 +20,46 @@ namespace sketch3D {
 	class spineEstimator : public baseGraphHandler {
 	private:
 		std::vector<spine*> spines;
+		pool<spine> spinePool;// spines are allocated from here and released by init()
 		size_t pointNum;
+		uint32_t spineEpoch;// a spine's flag is true if its mark == spineEpoch
+
+		//edge e is an edge of the polygon (points[i]->points[i+1]) or not
+		bool isPolygonEdge(graph::edgeIndex e);
 
 		//*spine functions*
-		void addSpine(graph::edge* e1=nullptr,graph::edge* e2=nullptr,graph::point* p1=nullptr, graph::point*p2=nullptr);
+		void addSpine(graph::edgeIndex e1 = graph::NULL_EDGE, graph::edgeIndex e2 = graph::NULL_EDGE, graph::pointIndex p1 = graph::NULL_POINT, graph::pointIndex p2 = graph::NULL_POINT);
 		void resetSpineFlag();
+		void setSpineFlag(spine* s);
+		bool getSpineFlag(spine* s);
 		void deleteSpineFlagIsTrue();
 
-		//generate spines
-		void genSpineFromChordalAxisRec(graph::edge* e, graph::point* p = nullptr, spine* s = nullptr);
+		//a face to visit (or a joint point to insert) in genSpineFromChordalAxis
+		struct spineTask {
+			graph::edgeIndex e;
+			graph::pointIndex p;// mid point of edge e (NULL_POINT for the first face)
+			spine* s;// spine connected to p
+			bool insert;// inserts point p into the face of edge e
+		};
+		std::vector<spineTask> spineTasks;// explicit stack of genSpineFromChordalAxis
+
+		//work buffers (they keep their capacity between problems)
+		graph::edgeIndexStack faceStack;// faces to visit in deleteExternalEdge
+		std::vector<graph::pointIndex> fanPoints;// pvec of genFanTriangleRec
+		std::vector<graph::edgeIndex> edgeRemap;
+		std::vector<graph::pointIndex> pointRemap;
+		std::vector<bool> pointFlags;
+
+		//generate spines on the face of edge e and push the next faces
+		void genSpineFromChordalAxisStep(graph::edgeIndex e, graph::pointIndex p, spine* s);
+		void pushSpineTask(graph::edgeIndex e, graph::pointIndex p = graph::NULL_POINT, spine* s = nullptr, bool insert = false);
 		
 		//generate fan triangles
-		void genFanTriangle(graph::point* p1, graph::point* p2, graph::point* center, size_t pnum, graph::edge* se_prev, graph::edge* se_next);
+		void genFanTriangle(graph::pointIndex p1, graph::pointIndex p2, graph::pointIndex center, size_t pnum, graph::edgeIndex se_prev, graph::edgeIndex se_next);
 
-		//recursive function to generate fan triangles
-		void genFanTriangleRec(graph::edge* e, std::vector<graph::point*>& pvec, spine* s, spine* preS=nullptr, bool end=false);
+		//walks spines from a terminal spine to generate fan triangles (a loop, so the depth doesn't use the stack)
+		//pcircle: a bounding circle of pvec (a quick accept. pvec is scanned when it's inconclusive)
+		void genFanTriangleRec(graph::edgeIndex e, std::vector<graph::pointIndex>& pvec, graph::boundingCircle& pcircle, spine* s, spine* preS=nullptr, bool end=false);
 
 		//find terminal spine to generate fan triangles
 		void searchSpineToGenFan();
@@ -6,6 +6,11 @@
  */
 
 #include "utils.hpp"
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <dirent.h>
+#endif
 
 namespace fileUtils {
 
@@ -25,6 +30,7 @@ namespace fileUtils {
 		return file_str;
 	}
 
+#ifdef _WIN32
 	std::string read_txt(const WCHAR* file_path) {
 		std::string file_str = "";
 		std::ifstream fstream(file_path, std::ios::in);
@@ -39,6 +45,7 @@ namespace fileUtils {
 		}
 		return file_str;
 	}
+#endif
 
 	//write string to a file
 	bool write_txt(const char* file_path, std::string str) {
@@ -54,6 +61,7 @@ namespace fileUtils {
 		return !err;
 	}
 
+#ifdef _WIN32
 	bool write_txt(const WCHAR* file_path, std::string str) {
 		std::ofstream fstream(file_path);
 		bool err = !fstream;
@@ -66,6 +74,7 @@ namespace fileUtils {
 		fstream.close();
 		return !err;
 	}
+#endif
 
 	int mkdir(const char* dir) {
 		//already exist = 1
@@ -73,9 +82,60 @@ namespace fileUtils {
 		//fail = -1
 		struct stat statBuf;
 		if (stat(dir, &statBuf) == 0) { return 1; }
+#ifdef _WIN32
 		return _mkdir(dir);
+#else
+		return ::mkdir(dir, 0755);
+#endif
 	}
 
+	bool isDirectory(const char* path) {
+		struct stat statBuf;
+		if (stat(path, &statBuf) != 0) { return false; }
+		return (statBuf.st_mode & S_IFMT) == S_IFDIR;
+	}
+
+	std::vector<std::string> listFiles(const char* dir, const char* ext) {
+		std::vector<std::string> files;
+		std::string dirStr(dir);
+		std::string extStr(ext);
+		if (!dirStr.empty() && dirStr.back() != '/' && dirStr.back() != '\\') {
+			dirStr += "/";
+		}
+		std::vector<std::string> names;
+#ifdef _WIN32
+		WIN32_FIND_DATAA findData;
+		HANDLE handle = FindFirstFileA((dirStr + "*").c_str(), &findData);
+		if (handle != INVALID_HANDLE_VALUE) {
+			do {
+				if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+					names.push_back(findData.cFileName);
+				}
+			} while (FindNextFileA(handle, &findData));
+			FindClose(handle);
+		}
+#else
+		DIR* dp = opendir(dir);
+		if (dp != NULL) {
+			struct dirent* entry;
+			while ((entry = readdir(dp)) != NULL) {
+				names.push_back(entry->d_name);
+			}
+			closedir(dp);
+		}
+#endif
+		for (size_t i = 0; i < names.size(); i++) {
+			const std::string& name = names[i];
+			if (name.size() > extStr.size() && name.compare(name.size() - extStr.size(), extStr.size(), extStr) == 0) {
+				files.push_back(dirStr + name);
+			}
+		}
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+
+#ifdef _WIN32
+
 	//show error info about GetOpenFileName function
 	void getDlgError() {
 		bool ErrCode = CommDlgExtendedError();
@@ -154,6 +214,8 @@ namespace fileUtils {
 		else { return true; }
 	}
 
+#endif
+
 }
 
 namespace stringUtils{
@@ -222,7 +284,11 @@ namespace stringUtils{
 		char buffer[80];
 
 		time(&rawtime);
+#ifdef _WIN32
 		localtime_s(&timeinfo, &rawtime);
+#else
+		localtime_r(&rawtime, &timeinfo);
+#endif
 
 		strftime(buffer, sizeof(buffer), "%Y%m%d_%H%M%S", &timeinfo);
 		std::string str(buffer);
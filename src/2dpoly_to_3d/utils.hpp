@@ -8,28 +8,48 @@
 
 #pragma once
 #include <iostream>
-#include <windows.h>
 #include <fstream>
 #include <sstream>
+#include <string>
 #include <vector>
-#include <direct.h>
+#include <algorithm>
+#include <cfloat>
 #include <ctime>
 
+//Win32 file dialogs and WCHAR paths are only available on Windows.
+//(the other functions are portable)
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <direct.h>
+#endif
+
 namespace fileUtils {
 	//read a file as txt
 	std::string read_txt(const char* file_path);
-	std::string read_txt(const WCHAR* file_path);
 
 	//write string to a file
 	bool write_txt(const char* file_path, std::string str);
-	bool write_txt(const WCHAR* file_path, std::string str);
 
 	//make directory
 	int mkdir(const char* dir);
 
+	//true if path is a directory
+	bool isDirectory(const char* path);
+
+	//get paths of files in dir (not recursive) which end with ext (e.g. ".stroke"), sorted by name
+	std::vector<std::string> listFiles(const char* dir, const char* ext);
+
+#ifdef _WIN32
+	std::string read_txt(const WCHAR* file_path);
+	bool write_txt(const WCHAR* file_path, std::string str);
+
 	//select a file in explorer
 	bool selectOpenFileInExplorer(WCHAR* FileName, LPCWSTR FilterSpec, LPCWSTR DefExt, LPCWSTR Title = L"Open....", LPCWSTR InitialPath = L".");
 	bool selectSaveFileInExplorer(WCHAR* FileName, LPCWSTR FilterSpec, LPCWSTR DefExt, LPCWSTR Title = L"Save as....", LPCWSTR InitialPath = L".");
+#endif
 }
 
 namespace stringUtils {
@@ -0,0 +1,177 @@
+/*
+ * File: sketch3d.cpp
+ * --------------------
+ *
+ * See sketch3d.h for documentation of each function.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#include "sketch3d.h"
+#include "2dpoly_to_3d.hpp"
+#include <new>
+#include <string>
+
+//the opaque handle
+struct sketch3d_context {
+	sketch3D::poly_to_3D polyTo3D;
+	int triangulator;
+	bool hasModel;
+	mutable std::string error;// the message of the last error (getters can set it)
+	sketch3d_context() : polyTo3D(), triangulator(sketch3D::TRIANGULATOR_CDT), hasModel(false), error() {
+		//outputs are written to caller's buffers, so 2D stages are not needed
+		polyTo3D.setSnapshotLevel(sketch3D::SNAPSHOT_NONE);
+	}
+};
+
+namespace {
+	//sets s1 + s2 + s3 + s4 as the message of the last error
+	//(never throws. the message will be empty if there is no memory for it)
+	int setError(const sketch3d_context* ctx, int status, const char* s1, const char* s2 = "", const char* s3 = "", const char* s4 = "") {
+		try {
+			ctx->error.assign(s1).append(s2).append(s3).append(s4);
+		}
+		catch (...) {
+			ctx->error.clear();
+		}
+		return status;
+	}
+
+	int clearError(const sketch3d_context* ctx) {
+		ctx->error.clear();
+		return SKETCH3D_OK;
+	}
+
+	bool isValidMesh(int mesh) {
+		return mesh == SKETCH3D_MESH_HALF || mesh == SKETCH3D_MESH_FULL;
+	}
+}
+
+extern "C" {
+
+	int sketch3d_get_api_version(void) {
+		return SKETCH3D_API_VERSION;
+	}
+
+	sketch3d_context* sketch3d_create(void) {
+		try {
+			return new sketch3d_context();
+		}
+		catch (...) {
+			return nullptr;
+		}
+	}
+
+	void sketch3d_destroy(sketch3d_context* ctx) {
+		delete ctx;
+	}
+
+	int sketch3d_set_triangulator(sketch3d_context* ctx, int triangulator) {
+		if (ctx == nullptr) return SKETCH3D_ERROR_INVALID_ARGUMENT;
+		if (triangulator != SKETCH3D_TRIANGULATOR_CDT && triangulator != SKETCH3D_TRIANGULATOR_EAR_CLIPPING) {
+			return setError(ctx, SKETCH3D_ERROR_INVALID_ARGUMENT, "sketch3d_set_triangulator: unknown triangulator");
+		}
+		ctx->triangulator = triangulator == SKETCH3D_TRIANGULATOR_CDT ? sketch3D::TRIANGULATOR_CDT : sketch3D::TRIANGULATOR_EAR_CLIPPING;
+		return clearError(ctx);
+	}
+
+	int sketch3d_set_ring_num(sketch3d_context* ctx, uint32_t ring_num) {
+		if (ctx == nullptr) return SKETCH3D_ERROR_INVALID_ARGUMENT;
+		if (ring_num < 1) {
+			return setError(ctx, SKETCH3D_ERROR_INVALID_ARGUMENT, "sketch3d_set_ring_num: ring_num should be 1 or more");
+		}
+		ctx->polyTo3D.setRingNum(ring_num);
+		return clearError(ctx);
+	}
+
+	int sketch3d_generate(sketch3d_context* ctx, const double* points, uint32_t point_num) {
+		if (ctx == nullptr) return SKETCH3D_ERROR_INVALID_ARGUMENT;
+		ctx->hasModel = false;
+		if (points == nullptr) {
+			return setError(ctx, SKETCH3D_ERROR_INVALID_ARGUMENT, "sketch3d_generate: points is NULL");
+		}
+		try {
+			ctx->polyTo3D.init();
+			//genModel doesn't modify the points
+			ctx->polyTo3D.genModel(const_cast<double*>(points), point_num, ctx->triangulator);
+		}
+		catch (graph::graphException& e) {
+			//expected exceptions are caused by the polygon
+			return setError(ctx, e.getUnexpected() ? SKETCH3D_ERROR_INTERNAL : SKETCH3D_ERROR_INVALID_POLYGON, "ERROR: ", e.getType(), "::", e.what());
+		}
+		catch (std::bad_alloc&) {
+			return setError(ctx, SKETCH3D_ERROR_INTERNAL, "ERROR: out of memory");
+		}
+		catch (std::exception& e) {
+			return setError(ctx, SKETCH3D_ERROR_INTERNAL, "ERROR: ", e.what());
+		}
+		catch (...) {
+			return setError(ctx, SKETCH3D_ERROR_INTERNAL, "ERROR: unexpected exception");
+		}
+		if (ctx->polyTo3D.getModelPointNum(true) > UINT32_MAX || ctx->polyTo3D.getModelFaceNum(true) > UINT32_MAX) {
+			return setError(ctx, SKETCH3D_ERROR_INTERNAL, "sketch3d_generate: the model is too large for uint32 indices");
+		}
+		ctx->hasModel = true;
+		return clearError(ctx);
+	}
+
+	int sketch3d_get_mesh_size(const sketch3d_context* ctx, int mesh, uint32_t* vertex_num, uint32_t* face_num) {
+		if (ctx == nullptr) return SKETCH3D_ERROR_INVALID_ARGUMENT;
+		if (!isValidMesh(mesh)) {
+			return setError(ctx, SKETCH3D_ERROR_INVALID_ARGUMENT, "sketch3d_get_mesh_size: unknown mesh");
+		}
+		if (!ctx->hasModel) {
+			return setError(ctx, SKETCH3D_ERROR_NO_MODEL, "sketch3d_get_mesh_size: there is no model");
+		}
+		sketch3D::poly_to_3D& polyTo3D = const_cast<sketch3d_context*>(ctx)->polyTo3D;
+		bool mirrored = mesh == SKETCH3D_MESH_FULL;
+		if (vertex_num != nullptr) *vertex_num = (uint32_t)polyTo3D.getModelPointNum(mirrored);
+		if (face_num != nullptr) *face_num = (uint32_t)polyTo3D.getModelFaceNum(mirrored);
+		return clearError(ctx);
+	}
+
+	int sketch3d_get_seam_num(const sketch3d_context* ctx, uint32_t* seam_num) {
+		if (ctx == nullptr) return SKETCH3D_ERROR_INVALID_ARGUMENT;
+		if (seam_num == nullptr) {
+			return setError(ctx, SKETCH3D_ERROR_INVALID_ARGUMENT, "sketch3d_get_seam_num: seam_num is NULL");
+		}
+		if (!ctx->hasModel) {
+			return setError(ctx, SKETCH3D_ERROR_NO_MODEL, "sketch3d_get_seam_num: there is no model");
+		}
+		*seam_num = (uint32_t)const_cast<sketch3d_context*>(ctx)->polyTo3D.getSeamPointNum();
+		return clearError(ctx);
+	}
+
+	int sketch3d_write_mesh(sketch3d_context* ctx, int mesh,
+		float* vertices, uint32_t vertex_capacity,
+		uint32_t* indices, uint32_t face_capacity,
+		float* normals) {
+		if (ctx == nullptr) return SKETCH3D_ERROR_INVALID_ARGUMENT;
+		if (!isValidMesh(mesh)) {
+			return setError(ctx, SKETCH3D_ERROR_INVALID_ARGUMENT, "sketch3d_write_mesh: unknown mesh");
+		}
+		if (!ctx->hasModel) {
+			return setError(ctx, SKETCH3D_ERROR_NO_MODEL, "sketch3d_write_mesh: there is no model");
+		}
+		bool mirrored = mesh == SKETCH3D_MESH_FULL;
+		size_t vertexNum = ctx->polyTo3D.getModelPointNum(mirrored);
+		size_t faceNum = ctx->polyTo3D.getModelFaceNum(mirrored);
+		if (((vertices != nullptr || normals != nullptr) && vertex_capacity < vertexNum)
+			|| (indices != nullptr && face_capacity < faceNum)) {
+			return setError(ctx, SKETCH3D_ERROR_BUFFER_TOO_SMALL, "sketch3d_write_mesh: buffer is too small");
+		}
+		try {
+			ctx->polyTo3D.writeModel(vertices, indices, normals, mirrored);
+		}
+		catch (...) {
+			return setError(ctx, SKETCH3D_ERROR_INTERNAL, "ERROR: unexpected exception");
+		}
+		return clearError(ctx);
+	}
+
+	const char* sketch3d_get_error(const sketch3d_context* ctx) {
+		if (ctx == nullptr) return "sketch3d: context is NULL";
+		return ctx->error.c_str();
+	}
+}
@@ -0,0 +1,118 @@
+/*
+ * File: sketch3d.h
+ * --------------------
+ * C API of 2Dpoly_to_3D (the sketch3d shared library).
+ *
+ * Only C types cross the library boundary and no exception escapes it.
+ * A context is an opaque handle; contexts are independent, so each thread can use its own.
+ * Outputs are written to buffers the caller allocates, after asking their sizes.
+ *
+ * Usage:
+ *   sketch3d_context* ctx = sketch3d_create();
+ *   if (sketch3d_generate(ctx, xy, pointNum) == SKETCH3D_OK) {
+ *       uint32_t vnum, fnum;
+ *       sketch3d_get_mesh_size(ctx, SKETCH3D_MESH_FULL, &vnum, &fnum);
+ *       float* vertices = malloc(sizeof(float) * vnum * 3);
+ *       uint32_t* indices = malloc(sizeof(uint32_t) * fnum * 3);
+ *       float* normals = malloc(sizeof(float) * vnum * 3);
+ *       sketch3d_write_mesh(ctx, SKETCH3D_MESH_FULL, vertices, vnum, indices, fnum, normals);
+ *   }
+ *   else {
+ *       printf("%s\n", sketch3d_get_error(ctx));
+ *   }
+ *   sketch3d_destroy(ctx);
+ *
+ * Python (ctypes + NumPy) can pass arrays without copies:
+ *   vertices = numpy.empty((vnum, 3), numpy.float32)
+ *   lib.sketch3d_write_mesh(ctx, 1, vertices.ctypes.data_as(POINTER(c_float)), vnum, ...)
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(SKETCH3D_BUILD)
+#define SKETCH3D_API __declspec(dllexport)
+#else
+#define SKETCH3D_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define SKETCH3D_API __attribute__((visibility("default")))
+#else
+#define SKETCH3D_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* version of this API (changed when a signature or a behavior changes) */
+#define SKETCH3D_API_VERSION 1
+
+/* status codes */
+#define SKETCH3D_OK 0
+#define SKETCH3D_ERROR_INVALID_ARGUMENT 1 /* null handle, null buffer, or an invalid value */
+#define SKETCH3D_ERROR_INVALID_POLYGON 2 /* the polygon can't be a model (e.g. crossed lines) */
+#define SKETCH3D_ERROR_NO_MODEL 3 /* sketch3d_generate hasn't succeeded */
+#define SKETCH3D_ERROR_BUFFER_TOO_SMALL 4 /* a capacity is smaller than the size */
+#define SKETCH3D_ERROR_INTERNAL 5 /* unexpected errors (including out of memory) */
+
+/* triangulators */
+#define SKETCH3D_TRIANGULATOR_CDT 0
+#define SKETCH3D_TRIANGULATOR_EAR_CLIPPING 1
+
+/* meshes */
+#define SKETCH3D_MESH_HALF 0 /* the +z half. the first seam_num vertices are on z=0 */
+#define SKETCH3D_MESH_FULL 1 /* the closed model (the half and its mirror image) */
+
+typedef struct sketch3d_context sketch3d_context;
+
+/* returns SKETCH3D_API_VERSION of the library */
+SKETCH3D_API int sketch3d_get_api_version(void);
+
+/* makes a context (NULL if out of memory) */
+SKETCH3D_API sketch3d_context* sketch3d_create(void);
+
+/* destroys a context (NULL is ignored) */
+SKETCH3D_API void sketch3d_destroy(sketch3d_context* ctx);
+
+/* settings for the next sketch3d_generate */
+SKETCH3D_API int sketch3d_set_triangulator(sketch3d_context* ctx, int triangulator);
+SKETCH3D_API int sketch3d_set_ring_num(sketch3d_context* ctx, uint32_t ring_num);
+
+/*
+ * generates a model from a polygon.
+ * points: {p1_x, p1_y, p2_x, ...} (point_num * 2 finite numbers, 5 or more points)
+ * the polygon should have an area, and its lines should not cross or touch each other.
+ * SKETCH3D_ERROR_INVALID_POLYGON is returned for other polygons.
+ */
+SKETCH3D_API int sketch3d_generate(sketch3d_context* ctx, const double* points, uint32_t point_num);
+
+/* gets the numbers of vertices and faces of the mesh (SKETCH3D_MESH_HALF or SKETCH3D_MESH_FULL) */
+SKETCH3D_API int sketch3d_get_mesh_size(const sketch3d_context* ctx, int mesh, uint32_t* vertex_num, uint32_t* face_num);
+
+/* gets the number of vertices on the seam (z=0) */
+SKETCH3D_API int sketch3d_get_seam_num(const sketch3d_context* ctx, uint32_t* seam_num);
+
+/*
+ * writes the mesh to caller's buffers.
+ * vertices: {v1_x, v1_y, v1_z, v2_x, ...} (vertex_capacity * 3 floats)
+ * indices: {f1_v1, f1_v2, f1_v3, f2_v1, ...} (face_capacity * 3 elements, counterclockwise from outside)
+ * normals: unit vectors of vertices (vertex_capacity * 3 floats)
+ * any of the buffers can be NULL to skip it.
+ */
+SKETCH3D_API int sketch3d_write_mesh(sketch3d_context* ctx, int mesh,
+	float* vertices, uint32_t vertex_capacity,
+	uint32_t* indices, uint32_t face_capacity,
+	float* normals);
+
+/* gets the message of the last error of the context ("" if there is no error) */
+SKETCH3D_API const char* sketch3d_get_error(const sketch3d_context* ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,94 +29,108 @@ const bool LOG_STROKE = true;
 const char* LOG_DIR = "stroke";
 //-----------------
 
-openglHandler::openglHandler GL_handler= openglHandler::openglHandler();
+//state of the application.
+//(glut callbacks can't take user data, so they share this instance)
+struct appState {
+	openglHandler::openglHandler GL_handler;
 
-mouseLogger::mouseLogger Mlogger(LOGGER_POINT_NUM, MIN_DISTANCE);
+	mouseLogger::mouseLogger Mlogger;
 
-graph::graph directedGraph;
+	//3D model generator (it owns its graph)
+	sketch3D::poly_to_3D polyTo3D;
 
-//3D model generator
-sketch3D::poly_to_3D polyTo3D(&directedGraph);
+	//redisplay flag
+	GLboolean isRedisp;
 
-//redisplay flag
-GLboolean isRedisp = GL_FALSE;
+	//0:initial state, 1:drawing, 2:show 3D model
+	int writeMode;
 
-//0:initial state, 1:drawing, 2:show 3D model
-int writeMode = 0;
+	//if true then you can rotate 3D model
+	bool rotateMode;
 
-//if true then you can rotate 3D model
-bool rotateMode = false;
+	//window size
+	int width;
+	int height;
 
-//window size
-int width = WINDOW_W;
-int height = WINDOW_H;
+	//mouse parameters
+	int mouseX;
+	int mouseY;
+	int mouseDx, mouseDy;
+	int moveTimer; // >0 then display mouse cursor
 
-//mouse parameters
-int mouseX = 0;
-int mouseY = 0;
-int mouseDx=0, mouseDy=0;
-int moveTimer = 0; // >0 then display mouse cursor
+	//display settings
+	size_t show2DMode;
+	bool showSpine;
+	bool showConst;
+	bool darkMode;
+
+	appState() :
+		GL_handler(), Mlogger(LOGGER_POINT_NUM, MIN_DISTANCE), polyTo3D(),
+		isRedisp(GL_FALSE), writeMode(0), rotateMode(false),
+		width(WINDOW_W), height(WINDOW_H),
+		mouseX(0), mouseY(0), mouseDx(0), mouseDy(0), moveTimer(0),
+		show2DMode(4), showSpine(true), showConst(false), darkMode(true) {}
+};
+
+appState app;
 
 //update mouse parameters
 void moveMouse(int x, int y) {
 	//printf("move");
-	if (mouseX == x && mouseY == y) return;
-	mouseDx = x - mouseX;
-	mouseDy = y - mouseY;
-
-	mouseX = x;
-	mouseY = y;
-	isRedisp = GL_TRUE;
-	moveTimer = 100;
+	if (app.mouseX == x && app.mouseY == y) return;
+	app.mouseDx = x - app.mouseX;
+	app.mouseDy = y - app.mouseY;
+
+	app.mouseX = x;
+	app.mouseY = y;
+	app.isRedisp = GL_TRUE;
+	app.moveTimer = 100;
 }
 
 void rejectMessage() {
 	printf("Input rejected.\n\n");
-	writeMode = 0;
+	app.writeMode = 0;
 }
 
 
-double* spines;
-size_t spineNum;
-
 //send model data to opengl handler and get spine data
 void setModel() {
-	GL_handler.setModel(
-		polyTo3D.getPointerToPoints3D(),
-		polyTo3D.getPointerToFaces(),
-		polyTo3D.getPointerToPointNormal(),
-		polyTo3D.getPoint3DNum(),
-		polyTo3D.getFaceNum());
-	GL_handler.setModelColor((float)1.0, (float)1.0, (float)1.0);
-	GL_handler.setLightPos((float)0.1, 0, (float)-2.0);
+	app.GL_handler.setModel(
+		app.polyTo3D.getPointerToPoints3D(),
+		app.polyTo3D.getPointerToFaces(),
+		app.polyTo3D.getPointerToPointNormal(),
+		app.polyTo3D.getPoint3DNum(),
+		app.polyTo3D.getFaceNum());
+	app.GL_handler.setModelColor((float)1.0, (float)1.0, (float)1.0);
+	app.GL_handler.setLightPos((float)0.1, 0, (float)-2.0);
 	
-	GL_handler.resetModelRotation();
-	writeMode = 2;
-	rotateMode = false;
+	app.GL_handler.resetModelRotation();
+	app.writeMode = 2;
+	app.rotateMode = false;
 }
 
 //when push mouse button
 void mouse(int button, int state, int x, int y) {
 	//printf("mouses");
-	isRedisp = GL_TRUE;
+	app.isRedisp = GL_TRUE;
 	moveMouse(x, y);
 	if (button == GLUT_LEFT_BUTTON) {
 		if (state == GLUT_DOWN) {//LMB is pushed
 			//start logging
-			Mlogger.start(x * 2.0 / width - 1, 1 - y * 2.0 / height);
-			if (writeMode != 1) writeMode = 1;
+			app.Mlogger.start(x * 2.0 / app.width - 1, 1 - y * 2.0 / app.height);
+			if (app.writeMode != 1) app.writeMode = 1;
 		}
 		else {//LMB is released
-			if (writeMode == 1) {
+			if (app.writeMode == 1) {
 
 				//check stroke length
-				bool res = Mlogger.finishStroke();
+				bool res = app.Mlogger.finishStroke();
 				if (!res) {
 					printf("Stroke is too long.\n");
 					rejectMessage();
 					return;
 				}
-				size_t Mlog_pnum = Mlogger.getPnum();
+				size_t Mlog_pnum = app.Mlogger.getPnum();
 				if (Mlog_pnum < 5) {
 					printf("Stroke is too short.\n");
 					rejectMessage();
@@ -124,16 +138,16 @@ void mouse(int button, int state, int x, int y) {
 				}
 
 				//initialize generator
-				polyTo3D.init();
+				app.polyTo3D.init();
 				try {
 
 					//generate a 3D model from a 2D polygon
-					polyTo3D.genModel(Mlogger.getPoints(), Mlogger.getPnum());
+					app.polyTo3D.genModel(app.Mlogger.getPoints(), app.Mlogger.getPnum());
 
 					if (LOG_STROKE) {
 						//write stroke data to a file
 						std::string file = std::string(LOG_DIR) + "/autolog.stroke";
-						polyTo3D.exportAsStroke(file.c_str(), "stroke log");
+						app.polyTo3D.exportAsStroke(file.c_str(), "stroke log");
 					}
 
 					//send model data to opengl handler
@@ -144,7 +158,7 @@ void mouse(int button, int state, int x, int y) {
 					if (e.getUnexpected()) {
 						e.print();
 						std::string file = std::string(LOG_DIR) + "/" + stringUtils::getTime() + "_error.stroke";
-						polyTo3D.exportAsStroke(file.c_str(), e.getErrorMsg().c_str());
+						app.polyTo3D.exportAsStroke(file.c_str(), e.getErrorMsg().c_str());
 					}
 					else {
 						printf("Crossed lines detected.\n");
@@ -154,13 +168,13 @@ void mouse(int button, int state, int x, int y) {
 				catch (std::exception e) {
 					printf(e.what());
 					std::string file = std::string(LOG_DIR) + "/" + stringUtils::getTime() + "_error.stroke";
-					polyTo3D.exportAsStroke(file.c_str(), e.what());
+					app.polyTo3D.exportAsStroke(file.c_str(), e.what());
 					rejectMessage();
 				}
 				catch (...) {
 					printf("unexpected exception\n");
 					std::string file = std::string(LOG_DIR) + "/" + stringUtils::getTime() + "_error.stroke";
-					polyTo3D.exportAsStroke(file.c_str(), "unexpected error");
+					app.polyTo3D.exportAsStroke(file.c_str(), "unexpected error");
 					rejectMessage();
 				}
 			}
@@ -168,11 +182,11 @@ void mouse(int button, int state, int x, int y) {
 		return;
 	}
 	if (button == GLUT_MIDDLE_BUTTON) {
-		if (state == GLUT_DOWN && writeMode == 2) {
-			rotateMode = true;
+		if (state == GLUT_DOWN && app.writeMode == 2) {
+			app.rotateMode = true;
 		}
 		else {
-			rotateMode = false;
+			app.rotateMode = false;
 		}
 	}
 }
@@ -181,9 +195,9 @@ void mouse(int button, int state, int x, int y) {
 void motion(int x, int y) {
 	moveMouse(x, y);
 
-	if (writeMode == 1) Mlogger.log(x * 2.0 / width - 1, 1 - y * 2.0 / height);
-	if (writeMode == 2 && rotateMode) {
-		GL_handler.rotateModel((float)(mouseDy/300.0*ROT_SPEED),(float)(mouseDx/300.0 * ROT_SPEED));
+	if (app.writeMode == 1) app.Mlogger.log(x * 2.0 / app.width - 1, 1 - y * 2.0 / app.height);
+	if (app.writeMode == 2 && app.rotateMode) {
+		app.GL_handler.rotateModel((float)(app.mouseDy/300.0*ROT_SPEED),(float)(app.mouseDx/300.0 * ROT_SPEED));
 	}
 }
 
@@ -200,16 +214,12 @@ void exit() {
 	}
 
 	//close window
-	GL_handler.exit();
+	app.GL_handler.exit();
 }
 
-size_t show2DMode=4;
-bool showSpine = true;
-bool showConst = false;
-bool darkMode = true;
 void redisp(int value) {
-	moveTimer = (moveTimer - 1)*(int)(moveTimer>0);
-	if (isRedisp || writeMode==2){
+	app.moveTimer = (app.moveTimer - 1)*(int)(app.moveTimer>0);
+	if (app.isRedisp || app.writeMode==2){
 		bool pushW = GetKeyState('W') & 0x8000;
 		bool pushA = GetKeyState('A') & 0x8000;
 		bool pushS = GetKeyState('S') & 0x8000;
@@ -220,34 +230,34 @@ void redisp(int value) {
 			float x = (float)((0.0+pushS - pushW) / 20.0 * ROT_SPEED);
 			float y = (float)((0.0+pushD - pushA) / 20.0 * ROT_SPEED);
 			float z = (float)((0.0+pushE - pushQ) / 20.0 * ROT_SPEED);
-			GL_handler.rotateModel(x,y,z);
+			app.GL_handler.rotateModel(x,y,z);
 		}
 
 		if (GetKeyState('R') & 0x8000) {//push R
-			GL_handler.resetModelRotation();
+			app.GL_handler.resetModelRotation();
 		}
 		if (GetAsyncKeyState('C') & 1) {
-			darkMode = !darkMode;
+			app.darkMode = !app.darkMode;
 		}
 		if (GetAsyncKeyState('T') & 1) {
-			GL_handler.takeScreenShot();
+			app.GL_handler.takeScreenShot();
 		}
-		if (writeMode == 2) {
+		if (app.writeMode == 2) {
 			if (GetAsyncKeyState('Z') & 1) {
-				show2DMode = (show2DMode + 1) % 5;
+				app.show2DMode = (app.show2DMode + 1) % 5;
 			}
 			if (GetAsyncKeyState('X') & 1) {
-				showSpine = !showSpine;
+				app.showSpine = !app.showSpine;
 			}
 			if (GetAsyncKeyState('V') & 1) {
-				showConst = !showConst;
+				app.showConst = !app.showConst;
 			}
 			
 		}
 
 
 		glutPostRedisplay();
-		isRedisp = GL_FALSE;
+		app.isRedisp = GL_FALSE;
 	};
 	if (GetKeyState(0x1B) & 0x8000) {//push esc key
 		exit();
@@ -264,29 +274,29 @@ void disp(void) {
 	}
 	
 	//get window size
-	width = glutGet(GLUT_WINDOW_WIDTH);
-	height = glutGet(GLUT_WINDOW_HEIGHT);
+	app.width = glutGet(GLUT_WINDOW_WIDTH);
+	app.height = glutGet(GLUT_WINDOW_HEIGHT);
 
 	//clear buffer
-	glClearColor(!darkMode, !darkMode, !darkMode, 0);
+	glClearColor(!app.darkMode, !app.darkMode, !app.darkMode, 0);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	if (writeMode == 1) {
+	if (app.writeMode == 1) {
 		//draw points
 		glLineWidth(2);
-		GL_handler.draw_by_array(GL_LINE_STRIP, 
-			Mlogger.getPoints(),
-			(GLsizei)Mlogger.getPnum(),
+		app.GL_handler.draw_by_array(GL_LINE_STRIP, 
+			app.Mlogger.getPoints(),
+			(GLsizei)app.Mlogger.getPnum(),
 			0, 0, 1);
 	}
 
-	if (writeMode == 2) {
+	if (app.writeMode == 2) {
 		bool showModel = openglHandler::getShowModel();
 		bool show2DPoly = openglHandler::getShow2DPoly();
 		bool showNormal = openglHandler::getShowNormal();
 		if (showModel) {
 			//draw model
-			GL_handler.draw();
+			app.GL_handler.draw();
 		}
 
 		if (show2DPoly) {
@@ -294,51 +304,51 @@ void disp(void) {
 
 			//draw edges
 			glLineWidth(2);
-			GL_handler.draw_by_array(GL_LINES, 
-				polyTo3D.getPointerToEdges(show2DMode),
-				polyTo3D.getEdgeNum(show2DMode) * 2,
+			app.GL_handler.draw_by_array(GL_LINES, 
+				app.polyTo3D.getPointerToEdges(app.show2DMode),
+				app.polyTo3D.getEdgeNum(app.show2DMode) * 2,
 				0, 1, 0);
 
-			if (showConst) {
-				GL_handler.draw_by_array(GL_LINES,
-					polyTo3D.getPointerToEdges(0),
-					polyTo3D.getEdgeNum(0) * 2,
+			if (app.showConst) {
+				app.GL_handler.draw_by_array(GL_LINES,
+					app.polyTo3D.getPointerToEdges(0),
+					app.polyTo3D.getEdgeNum(0) * 2,
 					1, 0, 0);
 			}
 
 			//draw spines
-			if (show2DMode > 1 && showSpine) {
+			if (app.show2DMode > 1 && app.showSpine) {
 				glLineWidth(3);
-				GL_handler.draw_by_array(GL_LINES,
-					polyTo3D.getPointerToSpines(show2DMode - 2 - (show2DMode==4)),
-					polyTo3D.getSpineNum(show2DMode - 2 - (show2DMode==4)) * 2,
+				app.GL_handler.draw_by_array(GL_LINES,
+					app.polyTo3D.getPointerToSpines(app.show2DMode - 2 - (app.show2DMode==4)),
+					app.polyTo3D.getSpineNum(app.show2DMode - 2 - (app.show2DMode==4)) * 2,
 					1, 0, 0);
 			}
 
 			//draw points
 			glPointSize(8);
-			GL_handler.draw_by_array(GL_POINTS,
-				polyTo3D.getPointerToPoints2D(show2DMode),
-				polyTo3D.getPoint2DNum(show2DMode*(show2DMode!=3)),
-				0, 0, darkMode);
+			app.GL_handler.draw_by_array(GL_POINTS,
+				app.polyTo3D.getPointerToPoints2D(app.show2DMode),
+				app.polyTo3D.getPoint2DNum(app.show2DMode*(app.show2DMode!=3)),
+				0, 0, app.darkMode);
 		}
 
 		if (showNormal) {
 			//draw normals
-			GL_handler.draw_normalLines(1, 0, 0);
+			app.GL_handler.draw_normalLines(1, 0, 0);
 		}
 
 		if (!showModel && !show2DPoly && !showNormal) {
-			GL_handler.drawString("Don't you want to see anything...?", (float)-0.3, (float)0);
+			app.GL_handler.drawString("Don't you want to see anything...?", (float)-0.3, (float)0);
 		}
 	}
-	GL_handler.drawString("LMB:draw", (float)-0.98, (float)0.95);
-	GL_handler.drawString("RMB:menu", (float)-0.98, (float)0.90);
-	GL_handler.drawString("MMB:rotate", (float)-0.98, (float)0.85);
+	app.GL_handler.drawString("LMB:draw", (float)-0.98, (float)0.95);
+	app.GL_handler.drawString("RMB:menu", (float)-0.98, (float)0.90);
+	app.GL_handler.drawString("MMB:rotate", (float)-0.98, (float)0.85);
 
 	//draw mouse cursor
-	if (moveTimer > 0) {
-		GL_handler.draw_point((mouseX - width / 2.0) / width * 2, -(mouseY - height / 2.0) / height * 2, 3, 0, 1, 0);
+	if (app.moveTimer > 0) {
+		app.GL_handler.draw_point((app.mouseX - app.width / 2.0) / app.width * 2, -(app.mouseY - app.height / 2.0) / app.height * 2, 3, 0, 1, 0);
 	};
 
 	//update window
@@ -350,7 +360,8 @@ void disp(void) {
 }
 
 
-sketch3D::CDTsolver cdt(&directedGraph);
+graph::graph testGraph;
+sketch3D::CDTsolver cdt(&testGraph);
 double test_p[49*2];
 size_t test_p_num=49;
 size_t constraint[4] = { 8,26,31,36 };
@@ -384,7 +395,7 @@ void testdisp() {
 	cdt.getPointsEdgesAsCoords(test_p, edges);
 	glLineWidth(2);
 	/*
-	GL_handler.draw_by_array(GL_LINES,
+	app.GL_handler.draw_by_array(GL_LINES,
 		edges,
 		edgeNum * 2,
 		0, 1, 0);*/
@@ -392,15 +403,15 @@ void testdisp() {
 		glLineWidth(3);
 		glColor3f(1, 0, 0);
 		glBegin(GL_LINES);
-		graph::point* p;
+		graph::point p;
 		for (size_t i = 0; i < constNum*2; i++) {
-			p = directedGraph.getPoint(constraint[i]);
-			glVertex2d(p->getX(), p->getY());
+			p = testGraph.getPoint(constraint[i]);
+			glVertex2d(p.getX(), p.getY());
 		}
 		glEnd();
 	}
 	glPointSize(8);
-	GL_handler.draw_by_array(GL_POINTS, test_p, test_p_num, 0,0,0);
+	app.GL_handler.draw_by_array(GL_POINTS, test_p, test_p_num, 0,0,0);
 	glFinish();
 	delete[] edges;
 }
@@ -416,7 +427,7 @@ int main(int argc, char** argv) {
 	if (false) {
 		glutInit(&argc, argv);
 		glutInitWindowPosition(100, 50);
-		glutInitWindowSize(width, height);
+		glutInitWindowSize(app.width, app.height);
 		glutInitDisplayMode(GLUT_SINGLE | GLUT_RGBA);
 
 		glutCreateWindow(window_name);
@@ -425,8 +436,8 @@ int main(int argc, char** argv) {
 		glutDisplayFunc(testdisp);
 	}
 	else{
-		GL_handler.init(argc, argv, window_name, width, height);
-		openglHandler::connectPolyTo3D(&polyTo3D);
+		app.GL_handler.init(argc, argv, window_name, app.width, app.height);
+		openglHandler::connectPolyTo3D(&app.polyTo3D);
 		glutDisplayFunc(disp);
 		glutMouseFunc(mouse);
 		glutPassiveMotionFunc(passivemotion);
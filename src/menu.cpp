@@ -19,36 +19,52 @@ namespace openglHandler {
 		EXIT
 	};
 
-	bool show_normal;//show normal vector or not
+	//state of the popup menu.
+	//(glut menu callbacks can't take user data, so the menu functions share this instance)
+	struct menuState {
+		bool show_normal;//show normal vector or not
+		bool show_2dpoly;//show 2d polygon or not
+		bool show_model;//show 3d model or not
+		bool updateMenuFlag;
+		bool setModelFlag;
+		bool exitFlag;//if true then show close dialog
+		sketch3D::poly_to_3D* polyTo3D;
+		WCHAR FileName[MAX_PATH];
+		menuState() :
+			show_normal(false), show_2dpoly(false), show_model(true),
+			updateMenuFlag(false), setModelFlag(false), exitFlag(false),
+			polyTo3D(nullptr), FileName() {}
+	};
+
+	menuState state;
+
 	bool getShowNormal() {
-		return show_normal;
+		return state.show_normal;
 	}
 
-	bool show_2dpoly;//show 2d polygon or not
 	bool getShow2DPoly() {
-		return show_2dpoly;
+		return state.show_2dpoly;
 	}
 
-	bool show_model;//show 3d model or not
 	bool getShowModel() {
-		return show_model;
+		return state.show_model;
 	}
 
 	//update popup menu
 	void updateMenu() {
-		if (show_normal) {
+		if (state.show_normal) {
 			glutChangeToMenuEntry((int)MENU_TYPE::SHOW_NORMAL+1, "Hide Normal", (int)MENU_TYPE::SHOW_NORMAL);
 		}
 		else {
 			glutChangeToMenuEntry((int)MENU_TYPE::SHOW_NORMAL+1, "Show Normal", (int)MENU_TYPE::SHOW_NORMAL);
 		}
-		if (show_2dpoly) {
+		if (state.show_2dpoly) {
 			glutChangeToMenuEntry((int)MENU_TYPE::SHOW_2DPOLY + 1, "Hide 2D Polygon", (int)MENU_TYPE::SHOW_2DPOLY);
 		}
 		else {
 			glutChangeToMenuEntry((int)MENU_TYPE::SHOW_2DPOLY + 1, "Show 2D Polygon", (int)MENU_TYPE::SHOW_2DPOLY);
 		}
-		if (show_model) {
+		if (state.show_model) {
 			glutChangeToMenuEntry((int)MENU_TYPE::SHOW_MODEL + 1, "Hide Model", (int)MENU_TYPE::SHOW_MODEL);
 		}
 		else {
@@ -56,50 +72,44 @@ namespace openglHandler {
 		}
 	}
 
-	bool updateMenuFlag;
 	void checkUpdateMenu() {
-		if (updateMenuFlag) {
+		if (state.updateMenuFlag) {
 			updateMenu();
-			updateMenuFlag = !updateMenuFlag;
+			state.updateMenuFlag = !state.updateMenuFlag;
 		}
 	}
 
-	bool setModelFlag;
 	bool getSetModelFlag() {
-		return setModelFlag;
+		return state.setModelFlag;
 	}
 	void resetSetModelFlag() {
-		setModelFlag = false;
+		state.setModelFlag = false;
 	}
 
-	sketch3D::poly_to_3D* polyTo3D;
 	void connectPolyTo3D(sketch3D::poly_to_3D* p_to_3d) {
-		polyTo3D = p_to_3d;
+		state.polyTo3D = p_to_3d;
 	}
 
-	bool exitFlag=false;//if true then show close dialog
 	bool getExitFlag() {
-		return exitFlag;
+		return state.exitFlag;
 	}
 	void resetExitFlag() {
-		exitFlag = false;
+		state.exitFlag = false;
 	}
 
-	WCHAR FileName[MAX_PATH];
-
 	void menu(int item) {
 
 		switch (item)
 		{
 		case (int)MENU_TYPE::EXPORT_AS_OBJ:
 			//export 3D model as .obj
-			if (polyTo3D->getPoint3DNum() != 0) {
-				if (fileUtils::selectSaveFileInExplorer(FileName,
+			if (state.polyTo3D->getPoint3DNum() != 0) {
+				if (fileUtils::selectSaveFileInExplorer(state.FileName,
 					L"Object Files(.obj)\0*.obj\0All Files(.)\0*.*\0",
 					L"obj", 
 					L"Export Obj")) {
-					wprintf(L"save as %s\n", FileName);
-					if (!(polyTo3D->exportAsObj(FileName))) {
+					wprintf(L"save as %s\n", state.FileName);
+					if (!(state.polyTo3D->exportAsObj(state.FileName))) {
 						printf("save canceled");
 					}
 				}
@@ -111,14 +121,14 @@ namespace openglHandler {
 
 		case (int)MENU_TYPE::EXPORT_AS_STROKE:
 			//export input polygon
-			if (polyTo3D->getPoint3DNum() != 0) {
-				if (fileUtils::selectSaveFileInExplorer(FileName,
+			if (state.polyTo3D->getPoint3DNum() != 0) {
+				if (fileUtils::selectSaveFileInExplorer(state.FileName,
 					L"Stroke Log(.stroke)\0 * .stroke\0All Files(.)\0 * .*\0",
 					L"stroke",
 					L"Export Stroke",
 					L"stroke")) {
-					wprintf(L"save as %s\n", FileName);
-					if (!(polyTo3D->exportAsStroke(FileName, "stroke log"))) {
+					wprintf(L"save as %s\n", state.FileName);
+					if (!(state.polyTo3D->exportAsStroke(state.FileName, "stroke log"))) {
 						printf("save canceled");
 					}
 				}
@@ -131,16 +141,16 @@ namespace openglHandler {
 		case (int)MENU_TYPE::IMPORT_STROKE:
 			//import 2d polygon and generate 3d model
 			if (fileUtils::selectOpenFileInExplorer(
-				FileName,
+				state.FileName,
 				L"Stroke Log(.stroke)\0 * .stroke\0All Files(.)\0 * .*\0",
 				L"stroke",
 				L"Import stroke",
 				L"stroke"))
 			{
-				wprintf(L"import %s\n", FileName);
+				wprintf(L"import %s\n", state.FileName);
 				try {
-					polyTo3D->importStroke(FileName);
-					setModelFlag = true;
+					state.polyTo3D->importStroke(state.FileName);
+					state.setModelFlag = true;
 				}
 				catch(graph::graphException e){
 					e.print();
@@ -159,29 +169,29 @@ namespace openglHandler {
 			break;
 
 		case (int)MENU_TYPE::SHOW_NORMAL:
-			show_normal = !show_normal;
+			state.show_normal = !state.show_normal;
 			break;
 
 		case (int)MENU_TYPE::SHOW_2DPOLY:
-			show_2dpoly = !show_2dpoly;
+			state.show_2dpoly = !state.show_2dpoly;
 			break;
 
 		case (int)MENU_TYPE::SHOW_MODEL:
-			show_model = !show_model;
+			state.show_model = !state.show_model;
 			break;
 
 		case (int)MENU_TYPE::EXIT:
-			exitFlag = true;
+			state.exitFlag = true;
 			break;
 		}
-		updateMenuFlag = true;
+		state.updateMenuFlag = true;
 		return;
 	}
 
 	void menuInit() {
-		show_normal = false;
-		show_2dpoly = false;
-		show_model = true;
+		state.show_normal = false;
+		state.show_2dpoly = false;
+		state.show_model = true;
 
 		// Create a menu
 		glutCreateMenu(menu);
@@ -219,7 +219,13 @@ namespace openglHandler {
 		glEnable(GL_DEPTH_TEST);
 		glDepthFunc(GL_LEQUAL);
 		glBindVertexArray(vao);
-		glDrawElements(GL_TRIANGLES, faceNum * 3, GL_UNSIGNED_INT, 0);
+		//instance 0 is the model and instance 1 is its mirror image (z -> -z).
+		//the mirror image has the opposite winding, so it's drawn with GL_CW as front faces.
+		glFrontFace(GL_CCW);
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, faceNum * 3, GL_UNSIGNED_INT, 0, 1, 0);
+		glFrontFace(GL_CW);
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, faceNum * 3, GL_UNSIGNED_INT, 0, 1, 1);
+		glFrontFace(GL_CCW);
 		glBindVertexArray(0);
 		glUseProgram(0);
 	}
@@ -229,7 +235,7 @@ namespace openglHandler {
 
 		GLfloat c[3] = { r,g,b };
 		glUniform3fv(normalColorID, 1, c);
-		glDrawArrays(GL_LINES, 0, vertexNum * 2);
+		glDrawArraysInstanced(GL_LINES, 0, vertexNum * 2, 2);
 		glUseProgram(0);
 	}
 
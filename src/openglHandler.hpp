@@ -90,6 +90,7 @@ namespace openglHandler {
 		* Usage: GL_handler.setModel(vertices, indices, vnum, fnum);
 		* ---------------------------------
 		* Sets a model data.
+		* The model is the +z half, and its mirror image (z -> -z) is drawn by instancing.
 		* vertices : 3d coordinates of vertices. vertices={v1_x, v1_y, v1_z, v2_x, v2_y, v2_z , v3_x, ...}
 		* indices : Indices of vertices representing faces. indices={f1_v1, f1_v2, f1_v3, f2_v1, f2_v2, f2_v3, f3_v1, ...}
 		* vnum : the number of vertices. vnum = len(vertices) / 3
@@ -101,7 +102,7 @@ namespace openglHandler {
 		* Method: draw
 		* Usage: GL_handler.draw();
 		* ---------------------------------
-		* Draws the model.
+		* Draws the model and its mirror image.
 		*/
 		void draw();
 
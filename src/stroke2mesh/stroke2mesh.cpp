@@ -0,0 +1,299 @@
+/*
+ * File: stroke2mesh.cpp
+ * --------------------
+ *
+ * This program converts .stroke files to .obj files without a window.
+ * It uses the same generator as the demo application (2Dpoly_to_3D).
+ *
+ * Usage: stroke2mesh [options] <file.stroke or directory>...
+ *   -o <dir>  : output directory (default: the directory of each input file)
+ *   -t <name> : triangulator (cdt or ear, default: cdt)
+ *   -r <num>  : the number of ring points between spine and outline (default: 1)
+ *   -p <num>  : the number of threads (default: the number of cores)
+ *   -s <file> : writes results of all files as json
+ *   -n        : generates models without writing .obj files (for benchmarks)
+ *   -q        : prints only the summary
+ *
+ * Directories are expanded to .stroke files in them (not recursive).
+ * Each thread has its own generator, and files are shared by a work stealing pool.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#include "2dpoly_to_3d.hpp"
+#include "workStealingPool.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+//setting----------
+const char* VERSION = "0.9.0";
+//-----------------
+
+struct options {
+	std::string outDir;// empty: the directory of each input file
+	int triangulator;
+	size_t ringNum;
+	size_t threadNum;// 0: the number of cores
+	std::string summaryPath;// empty: no json
+	bool writeObj;
+	bool quiet;
+	std::vector<std::string> inputs;
+	options() : outDir(), triangulator(sketch3D::TRIANGULATOR_CDT), ringNum(1), threadNum(0),
+		summaryPath(), writeObj(true), quiet(false), inputs() {}
+};
+
+//the result of a file
+struct fileResult {
+	bool ok;
+	size_t vertexNum;
+	size_t faceNum;
+	size_t exactNum;// predicate calls that needed exact arithmetic
+	double ms;// time to read and generate
+	std::string output;
+	std::string error;
+	fileResult() : ok(false), vertexNum(0), faceNum(0), exactNum(0), ms(0), output(), error() {}
+};
+
+void printUsage() {
+	printf("stroke2mesh ver%s\n", VERSION);
+	printf("Usage: stroke2mesh [options] <file.stroke or directory>...\n");
+	printf("  -o <dir>  : output directory (default: the directory of each input file)\n");
+	printf("  -t <name> : triangulator (cdt or ear, default: cdt)\n");
+	printf("  -r <num>  : the number of ring points between spine and outline (default: 1)\n");
+	printf("  -p <num>  : the number of threads (default: the number of cores)\n");
+	printf("  -s <file> : writes results of all files as json\n");
+	printf("  -n        : generates models without writing .obj files\n");
+	printf("  -q        : prints only the summary\n");
+}
+
+//returns false if arguments are invalid
+bool parseArgs(int argc, char** argv, options* opt) {
+	for (int i = 1; i < argc; i++) {
+		std::string arg(argv[i]);
+		bool hasValue = i + 1 < argc;
+		if (arg == "-o" && hasValue) {
+			opt->outDir = argv[++i];
+		}
+		else if (arg == "-t" && hasValue) {
+			std::string name(argv[++i]);
+			if (name == "cdt") {
+				opt->triangulator = sketch3D::TRIANGULATOR_CDT;
+			}
+			else if (name == "ear") {
+				opt->triangulator = sketch3D::TRIANGULATOR_EAR_CLIPPING;
+			}
+			else {
+				printf("ERROR: unknown triangulator '%s'\n", name.c_str());
+				return false;
+			}
+		}
+		else if (arg == "-r" && hasValue) {
+			int num = atoi(argv[++i]);
+			if (num < 1) {
+				printf("ERROR: ring number should be 1 or more.\n");
+				return false;
+			}
+			opt->ringNum = (size_t)num;
+		}
+		else if (arg == "-p" && hasValue) {
+			int num = atoi(argv[++i]);
+			if (num < 1) {
+				printf("ERROR: thread number should be 1 or more.\n");
+				return false;
+			}
+			opt->threadNum = (size_t)num;
+		}
+		else if (arg == "-s" && hasValue) {
+			opt->summaryPath = argv[++i];
+		}
+		else if (arg == "-n") {
+			opt->writeObj = false;
+		}
+		else if (arg == "-q") {
+			opt->quiet = true;
+		}
+		else if (arg.size() > 1 && arg[0] == '-') {
+			printf("ERROR: unknown option '%s'\n", arg.c_str());
+			return false;
+		}
+		else if (fileUtils::isDirectory(arg.c_str())) {
+			std::vector<std::string> files = fileUtils::listFiles(arg.c_str(), ".stroke");
+			opt->inputs.insert(opt->inputs.end(), files.begin(), files.end());
+		}
+		else {
+			opt->inputs.push_back(arg);
+		}
+	}
+	return !opt->inputs.empty();
+}
+
+//"dir/name.stroke" -> "outDir/name.obj"
+std::string getOutputPath(const std::string& input, const std::string& outDir) {
+	size_t slash = input.find_last_of("/\\");
+	size_t nameStart = (slash == std::string::npos) ? 0 : slash + 1;
+	std::string name = input.substr(nameStart);
+	size_t dot = name.find_last_of('.');
+	if (dot != std::string::npos && dot > 0) {
+		name = name.substr(0, dot);
+	}
+	std::string dir = outDir.empty() ? input.substr(0, nameStart) : outDir + "/";
+	return dir + name + ".obj";
+}
+
+//escapes a string for json
+std::string jsonString(const std::string& str) {
+	std::string out = "\"";
+	char buf[8];
+	for (size_t i = 0; i < str.size(); i++) {
+		char c = str[i];
+		if (c == '"' || c == '\\') {
+			out += '\\';
+			out += c;
+		}
+		else if ((unsigned char)c < 0x20) {
+			snprintf(buf, sizeof(buf), "\\u%04x", (int)c);
+			out += buf;
+		}
+		else {
+			out += c;
+		}
+	}
+	return out + "\"";
+}
+
+//converts a file with the generator of the worker
+void convertFile(sketch3D::poly_to_3D& polyTo3D, const options& opt, const std::string& input, fileResult* result) {
+	typedef std::chrono::steady_clock clock;
+	try {
+		//read and generate (timed separately from writing)
+		clock::time_point t = clock::now();
+		polyTo3D.importStroke(input.c_str(), opt.triangulator);
+		result->ms = std::chrono::duration<double, std::milli>(clock::now() - t).count();
+
+		//the -z half is included in .obj, so it's counted here as well
+		result->vertexNum = polyTo3D.getModelPointNum(true);
+		result->faceNum = polyTo3D.getModelFaceNum(true);
+		result->exactNum = polyTo3D.getExactPredicateNum();
+
+		if (opt.writeObj) {
+			result->output = getOutputPath(input, opt.outDir);
+			if (!polyTo3D.exportAsObj(result->output.c_str())) {
+				throw(graph::graphException("stroke2mesh", "Failed to write a file.", false));
+			}
+		}
+		result->ok = true;
+	}
+	//(messages are copied here, since they can be owned by the generator)
+	catch (graph::graphException& e) {
+		result->error = e.getErrorMsg();
+	}
+	catch (std::exception& e) {
+		result->error = std::string("ERROR: ") + e.what();
+	}
+	catch (...) {
+		result->error = "ERROR: unexpected exception";
+	}
+}
+
+int main(int argc, char** argv) {
+	options opt;
+	if (!parseArgs(argc, argv, &opt)) {
+		printUsage();
+		return 1;
+	}
+	if (!opt.outDir.empty() && fileUtils::mkdir(opt.outDir.c_str()) < 0) {
+		printf("ERROR: can NOT make %s\n", opt.outDir.c_str());
+		return 1;
+	}
+
+	stroke2mesh::workStealingPool pool(opt.threadNum);
+	size_t threadNum = pool.getThreadNum();
+	//a generator for each thread
+	std::vector<std::unique_ptr<sketch3D::poly_to_3D>> generators;
+	for (size_t i = 0; i < threadNum; i++) {
+		generators.push_back(std::unique_ptr<sketch3D::poly_to_3D>(new sketch3D::poly_to_3D()));
+		generators[i]->setSnapshotLevel(sketch3D::SNAPSHOT_NONE);
+		generators[i]->setRingNum(opt.ringNum);
+	}
+
+	typedef std::chrono::steady_clock clock;
+	size_t fileNum = opt.inputs.size();
+	std::vector<fileResult> results(fileNum);
+	clock::time_point start = clock::now();
+	pool.run(fileNum, [&](size_t worker, size_t i) {
+		convertFile(*generators[worker], opt, opt.inputs[i], &results[i]);
+	});
+	double wallTime = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	size_t okNum = 0;
+	size_t vertexNum = 0, faceNum = 0, exactNum = 0;
+	double genTime = 0;
+	for (size_t i = 0; i < fileNum; i++) {
+		const fileResult& result = results[i];
+		if (result.ok) {
+			okNum++;
+			vertexNum += result.vertexNum;
+			faceNum += result.faceNum;
+			exactNum += result.exactNum;
+			genTime += result.ms;
+			if (!opt.quiet) {
+				printf("%s: v:%d, f:%d, %.3fms\n", opt.inputs[i].c_str(), (int)result.vertexNum, (int)result.faceNum, result.ms);
+			}
+		}
+		else {
+			printf("%s: %s\n", opt.inputs[i].c_str(), result.error.c_str());
+		}
+	}
+	size_t failNum = fileNum - okNum;
+	double modelsPerSec = wallTime > 0 ? okNum * 1000.0 / wallTime : 0;
+
+	printf("files:%d, ok:%d, failed:%d\n", (int)fileNum, (int)okNum, (int)failNum);
+	printf("v:%d, f:%d, exact predicates:%d\n", (int)vertexNum, (int)faceNum, (int)exactNum);
+	printf("threads:%d, steals:%d\n", (int)threadNum, (int)pool.getStealNum());
+	printf("generate:%.3fms (sum of threads), wall:%.3fms, %.1f models/s\n", genTime, wallTime, modelsPerSec);
+
+	if (!opt.summaryPath.empty()) {
+		std::string json = "{\n";
+		json += "\"version\": " + jsonString(VERSION) + ",\n";
+		json += "\"triangulator\": " + jsonString(opt.triangulator == sketch3D::TRIANGULATOR_CDT ? "cdt" : "ear") + ",\n";
+		json += "\"ringNum\": " + std::to_string(opt.ringNum) + ",\n";
+		json += "\"threads\": " + std::to_string(threadNum) + ",\n";
+		json += "\"steals\": " + std::to_string(pool.getStealNum()) + ",\n";
+		json += "\"files\": " + std::to_string(fileNum) + ",\n";
+		json += "\"ok\": " + std::to_string(okNum) + ",\n";
+		json += "\"failed\": " + std::to_string(failNum) + ",\n";
+		json += "\"vertices\": " + std::to_string(vertexNum) + ",\n";
+		json += "\"faces\": " + std::to_string(faceNum) + ",\n";
+		json += "\"exactPredicates\": " + std::to_string(exactNum) + ",\n";
+		json += "\"generateMs\": " + std::to_string(genTime) + ",\n";
+		json += "\"wallMs\": " + std::to_string(wallTime) + ",\n";
+		json += "\"modelsPerSec\": " + std::to_string(modelsPerSec) + ",\n";
+		json += "\"results\": [";
+		for (size_t i = 0; i < fileNum; i++) {
+			const fileResult& result = results[i];
+			json += (i == 0) ? "\n" : ",\n";
+			json += "{\"input\": " + jsonString(opt.inputs[i]);
+			json += ", \"ok\": " + std::string(result.ok ? "true" : "false");
+			if (result.ok) {
+				json += ", \"vertices\": " + std::to_string(result.vertexNum);
+				json += ", \"faces\": " + std::to_string(result.faceNum);
+				json += ", \"exactPredicates\": " + std::to_string(result.exactNum);
+				json += ", \"ms\": " + std::to_string(result.ms);
+				if (!result.output.empty()) {
+					json += ", \"output\": " + jsonString(result.output);
+				}
+			}
+			else {
+				json += ", \"error\": " + jsonString(result.error);
+			}
+			json += "}";
+		}
+		json += "\n]\n}";
+		if (!fileUtils::write_txt(opt.summaryPath.c_str(), json)) {
+			return 1;
+		}
+	}
+	return failNum == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/*
+ * File: workStealingPool.cpp
+ * --------------------
+ *
+ * See workStealingPool.hpp for documentation of each member.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#include "workStealingPool.hpp"
+#include <thread>
+
+namespace stroke2mesh {
+
+	workStealingPool::workStealingPool(size_t threadNum) :
+		threadNum(threadNum), queues(), stealNum(0)
+	{
+		if (this->threadNum == 0) {
+			this->threadNum = std::thread::hardware_concurrency();
+		}
+		if (this->threadNum == 0) {
+			this->threadNum = 1;
+		}
+		for (size_t i = 0; i < this->threadNum; i++) {
+			queues.push_back(std::unique_ptr<workerQueue>(new workerQueue()));
+		}
+	}
+
+	size_t workStealingPool::getThreadNum() {
+		return threadNum;
+	}
+
+	size_t workStealingPool::getStealNum() {
+		return stealNum;
+	}
+
+	bool workStealingPool::popTask(size_t worker, size_t* task) {
+		workerQueue& queue = *queues[worker];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty()) return false;
+		*task = queue.tasks.front();
+		queue.tasks.pop_front();
+		return true;
+	}
+
+	bool workStealingPool::stealTask(size_t worker, size_t* task) {
+		std::deque<size_t> stolen;
+		//visits the other queues from the next worker (so thieves are spread over victims)
+		for (size_t i = 1; i < threadNum && stolen.empty(); i++) {
+			workerQueue& victim = *queues[(worker + i) % threadNum];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			size_t num = (victim.tasks.size() + 1) / 2;
+			for (size_t j = 0; j < num; j++) {
+				stolen.push_front(victim.tasks.back());
+				victim.tasks.pop_back();
+			}
+		}
+		if (stolen.empty()) return false;
+		stealNum++;
+
+		*task = stolen.front();
+		stolen.pop_front();
+		if (!stolen.empty()) {
+			workerQueue& queue = *queues[worker];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.tasks.insert(queue.tasks.end(), stolen.begin(), stolen.end());
+		}
+		return true;
+	}
+
+	void workStealingPool::workerLoop(size_t worker, const std::function<void(size_t, size_t)>& task) {
+		size_t i;
+		//tasks are never added during a run, so the worker can finish when nothing is left to steal.
+		while (popTask(worker, &i) || stealTask(worker, &i)) {
+			task(worker, i);
+		}
+	}
+
+	void workStealingPool::run(size_t taskNum, const std::function<void(size_t, size_t)>& task) {
+		stealNum = 0;
+		for (size_t w = 0; w < threadNum; w++) {
+			size_t begin = taskNum * w / threadNum;
+			size_t end = taskNum * (w + 1) / threadNum;
+			queues[w]->tasks.clear();
+			for (size_t i = begin; i < end; i++) {
+				queues[w]->tasks.push_back(i);
+			}
+		}
+
+		std::vector<std::thread> threads;
+		for (size_t w = 1; w < threadNum; w++) {
+			threads.push_back(std::thread(&workStealingPool::workerLoop, this, w, std::cref(task)));
+		}
+		workerLoop(0, task);
+		for (size_t i = 0; i < threads.size(); i++) {
+			threads[i].join();
+		}
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * File: workStealingPool.hpp
+ * --------------------
+ * A thread pool runs indexed tasks with work stealing.
+ *
+ * Tasks are split into contiguous ranges, one for each worker.
+ * A worker takes tasks from the front of its own queue,
+ * and steals half of the remaining tasks from the back of another queue when its queue is empty.
+ * So a few heavy tasks in a range don't stall the other workers.
+ *
+ * See workStealingPool.cpp for implementation of each member.
+ *
+ * Author: Matyalatte
+ * Last updated: 2021/09/25
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace stroke2mesh {
+
+	class workStealingPool {
+	private:
+		//a queue of task indices (locked by each access)
+		struct workerQueue {
+			std::mutex mutex;
+			std::deque<size_t> tasks;
+		};
+
+		size_t threadNum;
+		std::vector<std::unique_ptr<workerQueue>> queues;// queues[worker]
+		std::atomic<size_t> stealNum;// the number of successful steals in the last run
+
+		//pops a task from the front of queues[worker]
+		bool popTask(size_t worker, size_t* task);
+
+		//moves half of the tasks in another queue to queues[worker] and pops one of them
+		bool stealTask(size_t worker, size_t* task);
+
+		//runs tasks until all queues are empty
+		void workerLoop(size_t worker, const std::function<void(size_t, size_t)>& task);
+
+	public:
+		//threadNum: the number of workers (0 means std::thread::hardware_concurrency())
+		workStealingPool(size_t threadNum = 0);
+
+		size_t getThreadNum();
+		size_t getStealNum();
+
+		/*
+		* Method: run
+		* Usage: pool.run(taskNum, [&](size_t worker, size_t i) { ... });
+		* ---------------------------------
+		* Calls task(worker, i) for each i in [0, taskNum) and waits for all of them.
+		* worker is the index of the thread in [0, threadNum), so tasks can use per-worker data without locks.
+		* The calling thread works as worker 0.
+		* task should not throw exceptions.
+		*/
+		void run(size_t taskNum, const std::function<void(size_t, size_t)>& task);
+	};
+}